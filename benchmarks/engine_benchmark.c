@@ -0,0 +1,156 @@
+/**
+ * @file engine_benchmark.c
+ * @brief Compare the Allocator engines on the same workloads.
+ *
+ * @details
+ * Every workload keeps a fixed number of slots and repeatedly picks
+ * a random slot, freeing its memory block if it holds one and
+ * allocating a new memory block otherwise. The random sequence is
+ * seeded identically for every engine, so all engines receive the
+ * same requests. Reported are the average time per operation and
+ * the number of allocations that failed, the latter hinting at
+ * the external fragmentation of the engine.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "../src/allocator/allocator.h"
+
+#define HEAP_SIZE (8 * 1024 * 1024)
+#define SLOT_COUNT 4096
+#define OPERATION_COUNT 1000000
+
+typedef struct {
+
+    const char* name;
+    AllocatorConfig config;
+
+} EngineCase;
+
+uint64_t random_state;
+
+uint64_t next_random() {
+
+    // xorshift64
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+
+    return random_state;
+
+}
+
+// Power-of-two sizes between 16 bytes and 4 KB
+size_t power_of_two_size() {
+
+    return (size_t) 16 << (next_random() % 9);
+
+}
+
+// Any size between 1 byte and 1 KB
+size_t mixed_size() {
+
+    return 1 + next_random() % 1024;
+
+}
+
+double elapsed_ns(struct timespec* start, struct timespec* end) {
+
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+
+}
+
+void run_workload(EngineCase* engine, const char* workload, size_t (*next_size)()) {
+
+    Allocator* alloc = create_allocator_with_config(HEAP_SIZE, engine->config);
+
+    if (alloc == NULL) {
+
+        printf("%-28s %-14s could not be created\n", engine->name, workload);
+        return;
+
+    }
+
+    set_allocator(alloc);
+
+    static void* slots[SLOT_COUNT];
+    for (size_t i = 0; i < SLOT_COUNT; i++) { slots[i] = NULL; }
+
+    random_state = 0x2545F4914F6CDD1Dull;
+    size_t failed_count = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t i = 0; i < OPERATION_COUNT; i++) {
+
+        size_t slot = next_random() % SLOT_COUNT;
+
+        if (slots[slot]) {
+
+            allocator_free(slots[slot]);
+            slots[slot] = NULL;
+
+        } else {
+
+            slots[slot] = allocator_malloc(next_size());
+            failed_count += slots[slot] == NULL;
+
+        }
+
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printf("%-28s %-14s %10.1f ns/op %10zu failed\n",
+        engine->name, workload, elapsed_ns(&start, &end) / OPERATION_COUNT, failed_count);
+
+    destroy_allocator();
+    release_allocator();
+
+}
+
+int main() {
+
+    EngineCase engines[7];
+
+    engines[0].name = "list, segregated fit";
+    engines[0].config = default_allocator_config();
+
+    engines[1].name = "list, best fit";
+    engines[1].config = default_allocator_config();
+    engines[1].config.placement_policy = BEST_FIT;
+
+    engines[2].name = "tlsf";
+    engines[2].config = default_allocator_config();
+    engines[2].config.engine = TLSF_ENGINE;
+
+    engines[3].name = "buddy";
+    engines[3].config = default_allocator_config();
+    engines[3].config.engine = BUDDY_ENGINE;
+
+    engines[4].name = "list, segregated fit, slabs";
+    engines[4].config = default_allocator_config();
+    engines[4].config.use_slabs = true;
+
+    engines[5].name = "tlsf, slabs";
+    engines[5].config = default_allocator_config();
+    engines[5].config.engine = TLSF_ENGINE;
+    engines[5].config.use_slabs = true;
+
+    engines[6].name = "list, next fit";
+    engines[6].config = default_allocator_config();
+    engines[6].config.placement_policy = NEXT_FIT;
+
+    for (size_t i = 0; i < 7; i++) {
+
+        run_workload(&engines[i], "power-of-two", power_of_two_size);
+        run_workload(&engines[i], "mixed", mixed_size);
+
+    }
+
+    return 0;
+
+}
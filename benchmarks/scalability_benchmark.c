@@ -0,0 +1,569 @@
+/**
+ * @file scalability_benchmark.c
+ * @brief Measure how the concurrency features scale with threads.
+ *
+ * @details
+ * Every setup runs each workload with 1, 2, 4, ... threads up to
+ * the maximum thread count. The "churn" workload keeps a fixed number
+ * of slots per thread, repeatedly freeing the memory block of a random
+ * slot or allocating a new one. The "cross-thread" workload passes
+ * every memory block to the next thread, which frees it, as in a
+ * producer/consumer pipeline.
+ *
+ * Reported are the throughput, the 50th, 99th and 99.9th percentile
+ * latency of a single malloc or free, and the scaling efficiency,
+ * being the throughput relative to that of a single thread times
+ * the thread count. The latencies include the cost of reading the
+ * clock around every operation.
+ *
+ * Usage: scalability_benchmark [max threads] [small|mixed|power-of-two] [operations per thread]
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "../src/allocator/allocator.h"
+#include "../src/arena/arena.h"
+
+#define HEAP_SIZE (64 * 1024 * 1024)
+#define THREAD_HEAP_SIZE (16 * 1024 * 1024)
+#define SLOT_COUNT 1024
+#define MAILBOX_SIZE 256
+#define MAX_THREADS 256
+
+typedef struct {
+
+    const char* name;
+
+    // Prepare the Allocators for a run with 'thread_count' threads
+    void (*setup)(size_t thread_count);
+    void (*teardown)(size_t thread_count);
+
+    // Called by every thread before it starts allocating
+    void (*thread_start)(size_t thread_index);
+
+    void* (*malloc)(size_t size);
+    void (*free)(void* ptr);
+
+} AllocatorSetup;
+
+// A single-producer single-consumer ring of memory blocks to be freed
+typedef struct {
+
+    void* ptrs[MAILBOX_SIZE];
+    atomic_size_t head;
+    atomic_size_t tail;
+
+} Mailbox;
+
+typedef struct {
+
+    AllocatorSetup* setup;
+    size_t index;
+    size_t thread_count;
+    bool cross_thread;
+    uint64_t random_state;
+
+    // Latency of every operation in nanoseconds
+    uint32_t* latencies;
+    size_t latency_count;
+
+} WorkerArgs;
+
+size_t (*next_size)(uint64_t* state);
+size_t operation_count = 200000;
+
+pthread_barrier_t start_barrier;
+pthread_barrier_t drain_barrier;
+Mailbox mailboxes[MAX_THREADS];
+
+/* ---------------- Size distributions ---------------- */
+
+uint64_t next_random(uint64_t* state) {
+
+    // xorshift64
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+
+}
+
+// Any size between 1 byte and 256 bytes
+size_t small_size(uint64_t* state) {
+
+    return 1 + next_random(state) % 256;
+
+}
+
+// Any size between 1 byte and 1 KB
+size_t mixed_size(uint64_t* state) {
+
+    return 1 + next_random(state) % 1024;
+
+}
+
+// Power-of-two sizes between 16 bytes and 4 KB
+size_t power_of_two_size(uint64_t* state) {
+
+    return (size_t) 16 << (next_random(state) % 9);
+
+}
+
+/* ---------------- Allocator setups ---------------- */
+
+Allocator* shared_alloc;
+AllocatorConfig shared_config;
+
+void shared_setup(size_t thread_count) {
+
+    (void) thread_count;
+    shared_alloc = create_allocator_with_config(HEAP_SIZE, shared_config);
+
+}
+
+void shared_teardown(size_t thread_count) {
+
+    (void) thread_count;
+    set_allocator(shared_alloc);
+    destroy_allocator();
+    release_allocator();
+
+}
+
+void no_thread_start(size_t thread_index) {
+
+    (void) thread_index;
+
+}
+
+void* shared_malloc(size_t size) {
+
+    return allocator_malloc_from(shared_alloc, size);
+
+}
+
+void shared_free(void* ptr) {
+
+    allocator_free_to(shared_alloc, ptr);
+
+}
+
+void locked_setup(size_t thread_count) {
+
+    shared_config = default_allocator_config();
+    shared_setup(thread_count);
+
+}
+
+void thread_cache_setup(size_t thread_count) {
+
+    shared_config = default_allocator_config();
+    shared_config.use_thread_cache = true;
+    shared_setup(thread_count);
+
+}
+
+void central_bin_setup(size_t thread_count) {
+
+    shared_config = default_allocator_config();
+    shared_config.use_central_bins = true;
+    shared_config.use_thread_cache = true;
+    shared_setup(thread_count);
+
+}
+
+void cpu_cache_setup(size_t thread_count) {
+
+    shared_config = default_allocator_config();
+    shared_config.use_central_bins = true;
+    shared_config.use_cpu_cache = true;
+    shared_setup(thread_count);
+
+}
+
+ArenaManager* arena_manager;
+
+void arena_setup(size_t thread_count) {
+
+    arena_manager = create_arena_manager(thread_count, HEAP_SIZE / 4, default_allocator_config());
+
+}
+
+void arena_teardown(size_t thread_count) {
+
+    (void) thread_count;
+    destroy_arena_manager(arena_manager);
+
+}
+
+void* arena_setup_malloc(size_t size) {
+
+    return arena_malloc(arena_manager, size);
+
+}
+
+void arena_setup_free(void* ptr) {
+
+    arena_free(arena_manager, ptr);
+
+}
+
+// Every thread owns a heap, the others queue their frees on it
+Allocator* thread_heaps[MAX_THREADS];
+size_t thread_heap_count;
+_Thread_local Allocator* own_heap;
+
+void thread_heap_setup(size_t thread_count) {
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_remote_frees = true;
+
+    for (size_t i = 0; i < thread_count; i++) {
+
+        thread_heaps[i] = create_allocator_with_config(THREAD_HEAP_SIZE, config);
+
+    }
+
+    thread_heap_count = thread_count;
+
+}
+
+void thread_heap_teardown(size_t thread_count) {
+
+    for (size_t i = 0; i < thread_count; i++) {
+
+        set_allocator(thread_heaps[i]);
+        destroy_allocator();
+        release_allocator();
+
+    }
+
+}
+
+void thread_heap_start(size_t thread_index) {
+
+    own_heap = thread_heaps[thread_index];
+    claim_allocator(own_heap);
+
+}
+
+void* thread_heap_malloc(size_t size) {
+
+    return allocator_malloc_from(own_heap, size);
+
+}
+
+void thread_heap_free(void* ptr) {
+
+    char* location = (char*) ptr;
+
+    for (size_t i = 0; i < thread_heap_count; i++) {
+
+        if (location >= thread_heaps[i]->heap_start && location < thread_heaps[i]->heap_end) {
+
+            allocator_free_to(thread_heaps[i], ptr);
+            return;
+
+        }
+
+    }
+
+}
+
+/* ---------------- Workloads ---------------- */
+
+uint64_t now_ns() {
+
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t) time.tv_sec * 1000000000ull + time.tv_nsec;
+
+}
+
+void record_latency(WorkerArgs* args, uint64_t start, uint64_t end) {
+
+    uint64_t latency = end - start;
+    args->latencies[args->latency_count++] = latency > UINT32_MAX ? UINT32_MAX : (uint32_t) latency;
+
+}
+
+void churn(WorkerArgs* args) {
+
+    AllocatorSetup* setup = args->setup;
+    void* slots[SLOT_COUNT] = { NULL };
+
+    for (size_t i = 0; i < operation_count; i++) {
+
+        size_t slot = next_random(&args->random_state) % SLOT_COUNT;
+        uint64_t start = now_ns();
+
+        if (slots[slot]) {
+
+            setup->free(slots[slot]);
+            slots[slot] = NULL;
+
+        } else {
+
+            slots[slot] = setup->malloc(next_size(&args->random_state));
+
+        }
+
+        record_latency(args, start, now_ns());
+
+    }
+
+    for (size_t i = 0; i < SLOT_COUNT; i++) {
+
+        setup->free(slots[i]);
+
+    }
+
+}
+
+/*
+ * Free the memory blocks waiting in the mailbox of the thread.
+ */
+void drain_mailbox(WorkerArgs* args, Mailbox* mailbox, bool timed) {
+
+    size_t tail = atomic_load_explicit(&mailbox->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&mailbox->head, memory_order_acquire);
+
+    while (tail != head) {
+
+        void* ptr = mailbox->ptrs[tail % MAILBOX_SIZE];
+        uint64_t start = timed ? now_ns() : 0;
+
+        args->setup->free(ptr);
+
+        if (timed && args->latency_count < operation_count) { record_latency(args, start, now_ns()); }
+
+        tail++;
+
+    }
+
+    atomic_store_explicit(&mailbox->tail, tail, memory_order_release);
+
+}
+
+void cross_thread(WorkerArgs* args) {
+
+    AllocatorSetup* setup = args->setup;
+    Mailbox* own = &mailboxes[args->index];
+    Mailbox* next = &mailboxes[(args->index + 1) % args->thread_count];
+
+    // Every iteration allocates a memory block and frees those received
+    while (args->latency_count < operation_count) {
+
+        drain_mailbox(args, own, true);
+
+        if (args->latency_count == operation_count) { break; }
+
+        uint64_t start = now_ns();
+        void* ptr = setup->malloc(next_size(&args->random_state));
+        record_latency(args, start, now_ns());
+
+        if (ptr == NULL) { continue; }
+
+        size_t head = atomic_load_explicit(&next->head, memory_order_relaxed);
+
+        if (head - atomic_load_explicit(&next->tail, memory_order_acquire) < MAILBOX_SIZE) {
+
+            next->ptrs[head % MAILBOX_SIZE] = ptr;
+            atomic_store_explicit(&next->head, head + 1, memory_order_release);
+
+        } else {
+
+            // The next thread is behind, free the memory block here
+            setup->free(ptr);
+
+        }
+
+    }
+
+    // Wait for every thread to stop sending before freeing the remainder
+    pthread_barrier_wait(&drain_barrier);
+    drain_mailbox(args, own, false);
+
+}
+
+void* worker(void* arg) {
+
+    WorkerArgs* args = (WorkerArgs*) arg;
+
+    args->setup->thread_start(args->index);
+    pthread_barrier_wait(&start_barrier);
+
+    if (args->cross_thread) {
+
+        cross_thread(args);
+
+    } else {
+
+        churn(args);
+
+    }
+
+    return NULL;
+
+}
+
+int compare_latencies(const void* first, const void* second) {
+
+    uint32_t a = *(const uint32_t*) first;
+    uint32_t b = *(const uint32_t*) second;
+
+    return (a > b) - (a < b);
+
+}
+
+/*
+ * Run a workload with 'thread_count' threads.
+ *
+ * @return The throughput in operations per second.
+ */
+double run(AllocatorSetup* setup, bool cross_thread, size_t thread_count, double single_throughput) {
+
+    setup->setup(thread_count);
+
+    pthread_t threads[MAX_THREADS];
+    WorkerArgs args[MAX_THREADS];
+
+    pthread_barrier_init(&start_barrier, NULL, thread_count + 1);
+    pthread_barrier_init(&drain_barrier, NULL, thread_count);
+
+    for (size_t i = 0; i < thread_count; i++) {
+
+        atomic_init(&mailboxes[i].head, 0);
+        atomic_init(&mailboxes[i].tail, 0);
+
+        args[i].setup = setup;
+        args[i].index = i;
+        args[i].thread_count = thread_count;
+        args[i].cross_thread = cross_thread;
+        args[i].random_state = 0x2545F4914F6CDD1Dull + i;
+        args[i].latencies = malloc(operation_count * sizeof(uint32_t));
+        args[i].latency_count = 0;
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+
+    }
+
+    pthread_barrier_wait(&start_barrier);
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < thread_count; i++) {
+
+        pthread_join(threads[i], NULL);
+
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    // Merge the latencies of all threads
+    size_t total = 0;
+    for (size_t i = 0; i < thread_count; i++) { total += args[i].latency_count; }
+
+    uint32_t* latencies = malloc(total * sizeof(uint32_t));
+    size_t offset = 0;
+
+    for (size_t i = 0; i < thread_count; i++) {
+
+        memcpy(latencies + offset, args[i].latencies, args[i].latency_count * sizeof(uint32_t));
+        offset += args[i].latency_count;
+        free(args[i].latencies);
+
+    }
+
+    qsort(latencies, total, sizeof(uint32_t), compare_latencies);
+
+    double throughput = total / seconds;
+    double efficiency = single_throughput > 0 ? throughput / (single_throughput * thread_count) : 1.0;
+
+    printf("%-22s %-13s %7zu %10.2f %8u %8u %8u %9.0f%%\n",
+        setup->name, cross_thread ? "cross-thread" : "churn", thread_count, throughput / 1e6,
+        latencies[total / 2], latencies[total * 99 / 100], latencies[total * 999 / 1000],
+        efficiency * 100);
+
+    free(latencies);
+    pthread_barrier_destroy(&start_barrier);
+    pthread_barrier_destroy(&drain_barrier);
+
+    setup->teardown(thread_count);
+
+    return throughput;
+
+}
+
+int main(int argc, char** argv) {
+
+    long processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t) (processor_count > 0 ? processor_count : 1);
+    const char* distribution = argc > 2 ? argv[2] : "mixed";
+    if (argc > 3) { operation_count = strtoul(argv[3], NULL, 10); }
+
+    if (max_threads == 0 || max_threads > MAX_THREADS || operation_count == 0) {
+
+        fprintf(stderr, "usage: %s [max threads] [small|mixed|power-of-two] [operations per thread]\n", argv[0]);
+        return 1;
+
+    }
+
+    if (strcmp(distribution, "small") == 0) {
+
+        next_size = small_size;
+
+    } else if (strcmp(distribution, "power-of-two") == 0) {
+
+        next_size = power_of_two_size;
+
+    } else {
+
+        distribution = "mixed";
+        next_size = mixed_size;
+
+    }
+
+    AllocatorSetup setups[] = {
+
+        { "locked", locked_setup, shared_teardown, no_thread_start, shared_malloc, shared_free },
+        { "thread cache", thread_cache_setup, shared_teardown, no_thread_start, shared_malloc, shared_free },
+        { "thread cache, central", central_bin_setup, shared_teardown, no_thread_start, shared_malloc, shared_free },
+        { "cpu cache, central", cpu_cache_setup, shared_teardown, no_thread_start, shared_malloc, shared_free },
+        { "arenas", arena_setup, arena_teardown, no_thread_start, arena_setup_malloc, arena_setup_free },
+        { "thread heaps, remote", thread_heap_setup, thread_heap_teardown, thread_heap_start,
+            thread_heap_malloc, thread_heap_free }
+
+    };
+
+    printf("%zu operations per thread, %s sizes\n\n", operation_count, distribution);
+    printf("%-22s %-13s %7s %10s %8s %8s %8s %10s\n",
+        "setup", "workload", "threads", "Mops/s", "p50 ns", "p99 ns", "p999 ns", "efficiency");
+
+    for (size_t i = 0; i < sizeof(setups) / sizeof(setups[0]); i++) {
+
+        for (int cross_thread = 0; cross_thread < 2; cross_thread++) {
+
+            double single_throughput = 0;
+
+            for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+
+                double throughput = run(&setups[i], cross_thread, threads, single_throughput);
+                if (threads == 1) { single_throughput = throughput; }
+
+            }
+
+        }
+
+    }
+
+    return 0;
+
+}
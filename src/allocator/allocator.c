@@ -1,1105 +1,4263 @@
+// Exposes sched_getcpu()
+#define _GNU_SOURCE
 #include <string.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sched.h>
 #include "allocator.h"
 #include "../other_modules/memory_data.h"
 #include "../linked_list/node.h"
 #include "../linked_list/linked_list_iterator.h"
-#include "../linked_list/merge_sort_linked_list.h"
+#include "../size_tree/size_tree.h"
 
 #include <stdio.h>
 
 /**
  * The Allocator currently referenced to when
- * using the Allocator functions.
+ * using the Allocator functions. Every thread
+ * references an Allocator of its own choosing.
  */
-static Allocator* current_alloc = NULL;
+static _Thread_local Allocator* current_alloc = NULL;
 
-Allocator* create_allocator(size_t heap_size) {
+// The memory blocks cached by the thread, a ThreadCache for each Allocator in use
+static _Thread_local ThreadCache thread_caches[THREAD_CACHE_SLOTS];
+
+// The ThreadCache handed back next once every ThreadCache is taken
+static _Thread_local size_t thread_cache_victim = 0;
+
+// Lets the ThreadCache be handed back once the thread exits
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+
+void acquire_lock(pthread_mutex_t* lock) {
+
+    if (pthread_mutex_lock(lock) == EOWNERDEAD) {
+
+        // A process sharing the heap died while holding the lock
+        pthread_mutex_consistent(lock);
+
+    }
+
+}
+
+bool try_acquire_lock(pthread_mutex_t* lock) {
+
+    int result = pthread_mutex_trylock(lock);
+
+    if (result == EOWNERDEAD) {
+
+        pthread_mutex_consistent(lock);
+        return true;
+
+    }
+
+    return result == 0;
+
+}
+
+size_t size_class(size_t size) {
+
+    // Memory blocks are at least 8 bytes, being size class 0
+    if (size < 8) { return 0; }
+
+    size_t index = (sizeof(size_t) * 8 - 1) - __builtin_clzl(size) - 3;
+
+    if (index >= NUM_SIZE_CLASSES) {
+
+        // The last bin holds every larger memory block
+        return NUM_SIZE_CLASSES - 1;
+
+    }
+
+    return index;
+
+}
+
+void bin_insert(Allocator* alloc, Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    size_t index = size_class(data->block_size);
+    Node* head = alloc->bins[index];
+
+    // Push the Node at the front of the bin
+    data->prev_free = NULL;
+    data->next_free = head;
+
+    if (head) {
+
+        ((MemoryData*) head->data)->prev_free = node;
+
+    }
+
+    alloc->bins[index] = node;
+    alloc->bin_map |= (size_t) 1 << index;
+
+}
+
+void bin_remove(Allocator* alloc, Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    size_t index = size_class(data->block_size);
+
+    // Unlink the Node from its neighbours within the bin
+    if (data->prev_free) {
+
+        ((MemoryData*) data->prev_free->data)->next_free = data->next_free;
+
+    } else {
+
+        alloc->bins[index] = data->next_free;
+
+    }
+
+    if (data->next_free) {
+
+        ((MemoryData*) data->next_free->data)->prev_free = data->prev_free;
+
+    }
+
+    data->prev_free = NULL;
+    data->next_free = NULL;
+
+    if (alloc->bins[index] == NULL) {
+
+        // The bin is empty
+        alloc->bin_map &= ~((size_t) 1 << index);
+
+    }
+
+}
+
+Node* bin_search(Allocator* alloc, size_t size) {
 
     // Realign to a factor of 8 for memory efficency
-    heap_size = align_size(heap_size);
+    size = align_size(size);
+
+    if (alloc == NULL) { return NULL; }
 
     /*
-     * The heap size must be at least this large to accommodate the
-     * initial Allocator metadata memory needed.
+     * The bin of the matching size class may hold memory blocks
+     * that are too small, therefore it has to be scanned.
+     * Any memory block in a larger size class fits.
      */
-    size_t initial_reserved_pool_size =
-        align_size(sizeof(Allocator))
-        + align_size(sizeof(LinkedList))
-        + align_size(sizeof(MemoryData))
-        + align_size(sizeof(Node));
-    if (heap_size <= initial_reserved_pool_size) {
+    size_t index = size_class(size);
+    Node* node = alloc->bins[index];
 
-        return NULL;
+    while (node) {
+
+        MemoryData* data = (MemoryData*) node->data;
+
+        if (size <= data->block_size) {
+
+            // A Node has been found
+            return node;
+
+        }
+
+        node = data->next_free;
 
     }
 
-    // Utilize the built-in C malloc to acquire the managed heap
-    char* heap_start = (char*) malloc(heap_size);
+    if (index + 1 >= NUM_SIZE_CLASSES) { return NULL; }
 
-    if (heap_start == NULL) {
+    size_t larger_bins = alloc->bin_map & (~(size_t) 0 << (index + 1));
 
-        // Memory error from malloc()
+    if (!larger_bins) {
+
+        // There is no larger free memory block
         return NULL;
 
     }
 
-    // Pointer to the end of the heap
-    char* heap_end = heap_start + heap_size;
+    return alloc->bins[__builtin_ctzl(larger_bins)];
 
-    // Initialize Allocator object at the end of the heap
-    Allocator* alloc = (Allocator*) (heap_end - align_size(sizeof(Allocator)));
+}
 
-    // Set Allocator member variables
-    alloc->heap_start = heap_start;
-    alloc->heap_end = heap_end;
-    alloc->reserved_pool_border =  heap_end - align_size(sizeof(Allocator));
-    alloc->initial_reserved_pool_size = initial_reserved_pool_size;
-    alloc->heap_size = heap_size;
-    alloc->reserved_pool_size = align_size(sizeof(Allocator));
-    alloc->meta_data_node_size = align_size(sizeof(MemoryData)) + align_size(sizeof(Node));
+/*
+ * @brief Update the references of a bin to a Node moved by cleansing.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node at its old location.
+ * @param3 The Node at its new location.
+ */
+void bin_relocate(Allocator* alloc, Node* node, Node* moved_node) {
 
-    /*
-     * Set the Allocator being used to let Allocator functions
-     * know which Allocator object to process.
-     *
-     * Also, store the current Allocator during the
-     * creation of this new Allocator to be able to set it
-     * back at the end of this function.
-     */
-    Allocator* stored_alloc = current_alloc;
-    set_allocator(alloc);
+    // The links of the moved Node lead to its neighbours, the old Node is not needed
+    (void) node;
 
-    // Increase the reserved pool to accommodate for the LinkedList
-    alloc->reserved_pool_border -= align_size(sizeof(LinkedList));
-    alloc->reserved_pool_size += align_size(sizeof(LinkedList));
+    MemoryData* moved_data = (MemoryData*) moved_node->data;
 
-    // Initialize LinkedList object
-    LinkedList* list = (LinkedList*) alloc->reserved_pool_border;
+    if (moved_data->prev_free) {
 
-    // Set LinkedList member variables
-    list->head = NULL;
-    list->tail = NULL;
-    list->size = 0;
-    list->next_id = 0;
+        ((MemoryData*) moved_data->prev_free->data)->next_free = moved_node;
 
-    // Set Allocator member variable
-    alloc->list = list;
+    } else {
 
-    // Initialize a Node referencing the entire user memory pool
-    void* memory_start = heap_start;
+        alloc->bins[size_class(moved_data->block_size)] = moved_node;
 
-    // Increase the reserved pool to accommodate for the MemoryData
-    alloc->reserved_pool_border -= align_size(sizeof(MemoryData));
-    alloc->reserved_pool_size += align_size(sizeof(MemoryData));
+    }
 
-    MemoryData* data = (MemoryData*) alloc->reserved_pool_border;
+    if (moved_data->next_free) {
 
-    /*
-    * Set MemoryData member variables.
-    *
-    * In determining the size of the initial user pool we also account
-    * for the Node which will be created and stored in the reserved pool.
-    * Therefore, we subtract the size of Node in the initial user pool.
-    */
-    size_t block_size =
-        heap_size
-        - alloc->reserved_pool_size
-        - align_size(sizeof(Node));
-    bool is_free = true;
-    data->memory_start = memory_start;
-    data->block_size = block_size;
-    data->is_free = is_free;
-    data->in_use = true;
+        ((MemoryData*) moved_data->next_free->data)->prev_free = moved_node;
 
-    // Increase the reserved pool to accommodate for the Node
-    alloc->reserved_pool_border -= align_size(sizeof(Node));
-    alloc->reserved_pool_size += align_size(sizeof(Node));
+    }
 
-    // Create Node containing the MemoryData
-    Node* node = (Node*) alloc->reserved_pool_border;
+}
 
-    // Set Node member variables
-    node->data_size = align_size(sizeof(MemoryData));
-    node->next = NULL;
-    node->id = 0;
-    node->data = (void*) data;
+/*
+ * @brief Insert a Node with a free memory block into the size tree.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node to be inserted.
+ */
+void best_fit_insert(Allocator* alloc, Node* node) {
 
-    add(list, node);
+    alloc->size_tree = size_tree_insert(alloc->size_tree, node);
 
-    // Set the Allocator back to the one before this new Allocator
-    set_allocator(stored_alloc);
+}
+
+/*
+ * @brief Remove a Node from the size tree.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node to be removed.
+ */
+void best_fit_remove(Allocator* alloc, Node* node) {
+
+    alloc->size_tree = size_tree_remove(alloc->size_tree, node);
 
-    return alloc;
 }
 
-char* retrieve_user_pool_border() {
+/*
+ * @brief Search the size tree for the smallest memory block fitting 'size'.
+ *
+ * @param1 The Allocator.
+ * @param2 The size requirement for the memory block.
+ * @return A Node with a memory block fitting the size requirement.
+ */
+Node* best_fit_search(Allocator* alloc, size_t size) {
 
-    if (!current_alloc) { return NULL; }
+    return size_tree_best_fit(alloc->size_tree, size, false);
 
-    LinkedList* list = current_alloc->list;
-    merge_sort_list(list);
+}
 
-    Node* found_node = NULL;
-    LinkedListIterator iter;
-    iter.current = list->head;
+/*
+ * @brief Search the size tree for the smallest memory block fitting
+ * 'size', preferring the lowest address among equal sizes.
+ *
+ * @param1 The Allocator.
+ * @param2 The size requirement for the memory block.
+ * @return A Node with a memory block fitting the size requirement.
+ */
+Node* address_ordered_best_fit_search(Allocator* alloc, size_t size) {
 
-    while (has_next(&iter)) {
+    return size_tree_best_fit(alloc->size_tree, size, true);
+
+}
+
+/*
+ * @brief Update the reference of the size tree to a Node moved by cleansing.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node at its old location, its MemoryData still intact.
+ * @param3 The Node at its new location.
+ */
+void best_fit_relocate(Allocator* alloc, Node* node, Node* moved_node) {
+
+    Node** link = size_tree_find_link(&alloc->size_tree, node);
+    *link = moved_node;
+
+}
+
+/*
+ * @brief Insert a Node with a free memory block into the ring of the
+ * next-fit policy. The Node is inserted behind the rover, which stays
+ * where the previous search left off, such that the memory block just
+ * freed or split off is the last one looked at by the next search.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node to be inserted.
+ */
+void next_fit_insert(Allocator* alloc, Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    Node* rover = alloc->rover;
+
+    if (rover == NULL) {
+
+        // The Node forms a ring on its own and the search starts at it
+        data->prev_free = node;
+        data->next_free = node;
+        alloc->rover = node;
+
+    } else {
+
+        MemoryData* rover_data = (MemoryData*) rover->data;
+
+        data->prev_free = rover_data->prev_free;
+        data->next_free = rover;
+        ((MemoryData*) rover_data->prev_free->data)->next_free = node;
+        rover_data->prev_free = node;
+
+    }
+
+}
+
+/*
+ * @brief Remove a Node from the ring of the next-fit policy. Should
+ * the rover reference the Node, the rover moves on to the next Node.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node to be removed.
+ */
+void next_fit_remove(Allocator* alloc, Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (data->next_free == node) {
+
+        // The last Node leaves the ring
+        alloc->rover = NULL;
+
+    } else {
+
+        ((MemoryData*) data->prev_free->data)->next_free = data->next_free;
+        ((MemoryData*) data->next_free->data)->prev_free = data->prev_free;
+
+        if (alloc->rover == node) {
+
+            alloc->rover = data->next_free;
+
+        }
+
+    }
+
+    data->prev_free = NULL;
+    data->next_free = NULL;
+
+}
+
+Node* next_fit_search(Allocator* alloc, size_t size) {
+
+    Node* rover = alloc->rover;
+
+    if (rover == NULL) { return NULL; }
+
+    // Go around the ring once, starting at the rover
+    Node* node = rover;
+
+    do {
 
-        Node* node = next(&iter);
         MemoryData* data = (MemoryData*) node->data;
 
-        if (data->is_free == false) {
+        if (size <= data->block_size) {
 
-            found_node = node;
+            // Resume at this Node the next time
+            alloc->rover = node;
+            return node;
 
         }
 
+        node = data->next_free;
+
+    } while (node != rover);
+
+    return NULL;
+
+}
+
+/*
+ * @brief Update the references of the ring of the next-fit policy
+ * to a Node moved by cleansing.
+ *
+ * @param1 The Allocator.
+ * @param2 The Node at its old location.
+ * @param3 The Node at its new location.
+ */
+void next_fit_relocate(Allocator* alloc, Node* node, Node* moved_node) {
+
+    MemoryData* moved_data = (MemoryData*) moved_node->data;
+
+    if (moved_data->next_free == node) {
+
+        // The Node forms a ring on its own
+        moved_data->prev_free = moved_node;
+        moved_data->next_free = moved_node;
+
+    } else {
+
+        ((MemoryData*) moved_data->prev_free->data)->next_free = moved_node;
+        ((MemoryData*) moved_data->next_free->data)->prev_free = moved_node;
+
     }
 
-    if (!found_node) {
+    if (alloc->rover == node) {
+
+        alloc->rover = moved_node;
+
+    }
+
+}
+
+const PlacementOps* placement_ops(PlacementPolicy policy) {
+
+    static const PlacementOps segregated_fit_ops =
+        { bin_insert, bin_remove, bin_search, bin_relocate };
+    static const PlacementOps best_fit_ops =
+        { best_fit_insert, best_fit_remove, best_fit_search, best_fit_relocate };
+    static const PlacementOps address_ordered_best_fit_ops =
+        { best_fit_insert, best_fit_remove, address_ordered_best_fit_search, best_fit_relocate };
+    static const PlacementOps next_fit_ops =
+        { next_fit_insert, next_fit_remove, next_fit_search, next_fit_relocate };
+
+    switch (policy) {
+
+        case BEST_FIT:
+            return &best_fit_ops;
+
+        case ADDRESS_ORDERED_BEST_FIT:
+            return &address_ordered_best_fit_ops;
+
+        case NEXT_FIT:
+            return &next_fit_ops;
+
+        default:
+            return &segregated_fit_ops;
+
+    }
+
+}
+
+/*
+ * @brief Retrieve the placement callbacks of the current Allocator.
+ * A shared heap is mapped by processes with code at different
+ * addresses, its callbacks are therefore derived from the policy.
+ *
+ * @return The table of the placement policy.
+ */
+const PlacementOps* current_placement() {
+
+    if (current_alloc->heap_source == HEAP_SHARED) {
+
+        return placement_ops(current_alloc->placement_policy);
+
+    }
+
+    return &current_alloc->placement;
+
+}
+
+void free_index_insert(Node* node) {
+
+    current_placement()->insert(current_alloc, node);
+
+}
+
+void free_index_remove(Node* node) {
+
+    current_placement()->remove(current_alloc, node);
+
+}
+
+Node* free_index_search(size_t size) {
+
+    // Realign to a factor of 8 for memory efficency
+    size = align_size(size);
+
+    if (current_alloc == NULL) { return NULL; }
+
+    return current_placement()->search(current_alloc, size);
+
+}
+
+Allocator* create_allocator(size_t heap_size) {
+
+    return create_allocator_with_config(heap_size, default_allocator_config());
+
+}
+
+AllocatorConfig default_allocator_config() {
+
+    AllocatorConfig config;
+    config.engine = LIST_ENGINE;
+    config.placement_policy = SEGREGATED_FIT;
+    config.placement_ops = NULL;
+    config.placement_state = NULL;
+    config.use_slabs = false;
+    config.use_thread_cache = false;
+    config.use_remote_frees = false;
+    config.use_central_bins = false;
+    config.use_cpu_cache = false;
+    config.use_maintenance_thread = false;
+    config.maintenance_interval_ms = 10;
+    config.use_mmap = false;
+    config.use_extents = false;
+    config.trim_threshold = 0;
+    config.trim_decay_ms = 1000;
+    config.huge_threshold = 0;
+
+    return config;
+
+}
+
+/*
+ * @brief Determine the capacity of the pointer index for a heap,
+ * being one entry for every 512 bytes rounded up to a power of two.
+ *
+ * @param The size of the managed heap.
+ * @return The number of entries of the pointer index.
+ */
+size_t pointer_index_capacity(size_t heap_size) {
+
+    size_t capacity = 16;
+
+    while (capacity < heap_size / 512) {
+
+        capacity *= 2;
+
+    }
+
+    return capacity;
+
+}
+
+/*
+ * @brief Read a monotonic clock.
+ *
+ * @return The time in milliseconds.
+ */
+size_t monotonic_ms() {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (size_t) now.tv_sec * 1000 + (size_t) now.tv_nsec / 1000000;
+
+}
+
+/*
+ * @brief Destroy the lock of an Allocator along with the locks
+ * of its central bins, CPU caches and huge memory block side table.
+ *
+ * @param The Allocator.
+ */
+void destroy_allocator_locks(Allocator* alloc) {
+
+    for (size_t i = 0; i < TCACHE_CLASS_COUNT; i++) {
+
+        pthread_mutex_destroy(&alloc->central_bins[i].lock);
+
+    }
+
+    for (size_t i = 0; alloc->use_cpu_cache && i < alloc->cpu_cache_count; i++) {
+
+        pthread_mutex_destroy(&alloc->cpu_caches[i].lock);
+
+    }
+
+    pthread_mutex_destroy(&alloc->huge_lock);
+    pthread_mutex_destroy(&alloc->lock);
+
+}
+
+/*
+ * @brief The maintenance thread of an Allocator, performing a
+ * maintenance step every 'maintenance_interval_ms' until stopped.
+ *
+ * @param The Allocator.
+ */
+void* maintenance_loop(void* arg) {
+
+    Allocator* alloc = (Allocator*) arg;
+
+    pthread_mutex_lock(&alloc->maintenance_lock);
+
+    while (!alloc->maintenance_stop) {
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        size_t nanoseconds = deadline.tv_nsec + (alloc->maintenance_interval_ms % 1000) * 1000000;
+        deadline.tv_sec += alloc->maintenance_interval_ms / 1000 + nanoseconds / 1000000000;
+        deadline.tv_nsec = nanoseconds % 1000000000;
+
+        pthread_cond_timedwait(&alloc->maintenance_wakeup, &alloc->maintenance_lock, &deadline);
+
+        if (alloc->maintenance_stop) { break; }
+
+        pthread_mutex_unlock(&alloc->maintenance_lock);
+        maintenance_step(alloc);
+        pthread_mutex_lock(&alloc->maintenance_lock);
+
+    }
+
+    pthread_mutex_unlock(&alloc->maintenance_lock);
+
+    return NULL;
+
+}
+
+/*
+ * @brief Start the maintenance thread of an Allocator, if enabled.
+ * On failure, the Allocator is left without one.
+ *
+ * @param The Allocator.
+ */
+void start_maintenance_thread(Allocator* alloc) {
+
+    if (!alloc->use_maintenance_thread) { return; }
+
+    pthread_mutex_init(&alloc->maintenance_lock, NULL);
+    pthread_cond_init(&alloc->maintenance_wakeup, NULL);
+
+    if (pthread_create(&alloc->maintenance_thread, NULL, maintenance_loop, alloc) != 0) {
+
+        pthread_cond_destroy(&alloc->maintenance_wakeup);
+        pthread_mutex_destroy(&alloc->maintenance_lock);
+        alloc->use_maintenance_thread = false;
+
+    }
+
+}
+
+/*
+ * @brief Stop the maintenance thread of an Allocator and wait for it.
+ *
+ * @param The Allocator.
+ */
+void stop_maintenance_thread(Allocator* alloc) {
+
+    if (!alloc->use_maintenance_thread) { return; }
+
+    pthread_mutex_lock(&alloc->maintenance_lock);
+    alloc->maintenance_stop = true;
+    pthread_cond_signal(&alloc->maintenance_wakeup);
+    pthread_mutex_unlock(&alloc->maintenance_lock);
+
+    pthread_join(alloc->maintenance_thread, NULL);
+
+    pthread_cond_destroy(&alloc->maintenance_wakeup);
+    pthread_mutex_destroy(&alloc->maintenance_lock);
+    alloc->use_maintenance_thread = false;
+
+}
+
+/*
+ * @brief Build an Allocator managing the memory at 'heap_start',
+ * placing the Allocator and its metadata at the top of it. The memory
+ * is left to the caller should the Allocator not fit.
+ *
+ * @param1 The start of the managed heap.
+ * @param2 The size of the managed heap, a factor of 8.
+ * @param3 The options of the Allocator.
+ * @param4 Where the managed heap comes from.
+ * @return The Allocator, or NULL if it could not be created.
+ */
+Allocator* create_allocator_in(char* heap_start, size_t heap_size, AllocatorConfig config, HeapSource source) {
+
+    // The pointer index grows along with the heap size
+    size_t index_capacity = pointer_index_capacity(heap_size);
+    size_t index_size = align_size(index_capacity * sizeof(PointerIndexEntry));
+
+    // The slabs keep a page map entry for every page of the managed heap
+    size_t page_count = heap_size / SLAB_SIZE + 1;
+    size_t slab_cache_size = config.use_slabs
+        ? align_size(sizeof(SlabCache)) + align_size(page_count * sizeof(Slab*))
+        : 0;
+
+    // One CpuCache for every configured CPU
+    long cpu_count = sysconf(_SC_NPROCESSORS_CONF);
+    size_t cpu_cache_count = config.use_cpu_cache ? (cpu_count > 0 ? (size_t) cpu_count : 1) : 0;
+    size_t cpu_cache_size = align_size(cpu_cache_count * sizeof(CpuCache));
+
+    /*
+     * The heap size must be at least this large to accommodate the
+     * initial Allocator metadata memory needed.
+     */
+    size_t initial_reserved_pool_size =
+        align_size(sizeof(Allocator))
+        + slab_cache_size
+        + cpu_cache_size
+        + align_size(sizeof(LinkedList))
+        + index_size
+        + align_size(sizeof(MemoryData))
+        + align_size(sizeof(Node));
+
+    if (config.engine == TLSF_ENGINE) {
+
+        // The TLSF engine only needs its TlsfControl next to the Allocator
+        initial_reserved_pool_size =
+            align_size(sizeof(Allocator)) + slab_cache_size + cpu_cache_size + align_size(sizeof(TlsfControl));
+
+    } else if (config.engine == BUDDY_ENGINE) {
+
+        // The buddy engine only needs its BuddyControl next to the Allocator
+        initial_reserved_pool_size =
+            align_size(sizeof(Allocator)) + slab_cache_size + cpu_cache_size + align_size(sizeof(BuddyControl));
+
+    }
+
+    if (heap_size <= initial_reserved_pool_size) {
+
+        return NULL;
+
+    }
+
+    // Pointer to the end of the heap
+    char* heap_end = heap_start + heap_size;
+
+    // Initialize Allocator object at the end of the heap
+    Allocator* alloc = (Allocator*) (heap_end - align_size(sizeof(Allocator)));
+
+    // Set Allocator member variables
+    alloc->heap_start = heap_start;
+    alloc->heap_end = heap_end;
+    alloc->reserved_pool_border =  heap_end - align_size(sizeof(Allocator));
+    alloc->initial_reserved_pool_size = initial_reserved_pool_size;
+    alloc->heap_size = heap_size;
+    alloc->heap_source = source;
+    alloc->reserved_pool_size = align_size(sizeof(Allocator));
+    alloc->meta_data_node_size = align_size(sizeof(MemoryData)) + align_size(sizeof(Node));
+
+    // All the bins start out empty
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+
+        alloc->bins[i] = NULL;
+
+    }
+    alloc->bin_map = 0;
+
+    alloc->placement_policy = config.placement_policy;
+    alloc->placement = config.placement_ops
+        ? *config.placement_ops
+        : *placement_ops(config.placement_policy);
+    alloc->placement_state = config.placement_state;
+    alloc->size_tree = NULL;
+    alloc->rover = NULL;
+    alloc->vacant_slots = NULL;
+
+    /*
+     * The lock is recursive, as the Allocator functions call each
+     * other, e.g. allocator_malloc() cleansing the pools.
+     */
+    pthread_mutexattr_t lock_attributes;
+    pthread_mutexattr_init(&lock_attributes);
+
+    if (source == HEAP_SHARED) {
+
+        // Other processes take the locks too, and may die while holding them
+        pthread_mutexattr_setpshared(&lock_attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&lock_attributes, PTHREAD_MUTEX_ROBUST);
+
+    }
+
+    for (size_t i = 0; i < TCACHE_CLASS_COUNT; i++) {
+
+        pthread_mutex_init(&alloc->central_bins[i].lock, &lock_attributes);
+        alloc->central_bins[i].stack = NULL;
+        alloc->central_bins[i].count = 0;
+
+    }
+
+    pthread_mutexattr_settype(&lock_attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&alloc->lock, &lock_attributes);
+    pthread_mutexattr_destroy(&lock_attributes);
+
+    alloc->engine = config.engine;
+    alloc->tlsf = NULL;
+    alloc->buddy = NULL;
+    alloc->list = NULL;
+    pointer_index_init(&alloc->pointer_index, NULL, 0);
+    alloc->unindexed_count = 0;
+    alloc->slabs = NULL;
+    alloc->use_thread_cache = config.use_thread_cache;
+    alloc->use_central_bins = config.use_central_bins;
+    alloc->use_block_headers = config.use_thread_cache || config.use_central_bins || config.use_cpu_cache;
+    alloc->thread_caches = NULL;
+    alloc->use_cpu_cache = config.use_cpu_cache;
+    alloc->cpu_caches = NULL;
+    alloc->cpu_cache_count = cpu_cache_count;
+    alloc->use_remote_frees = config.use_remote_frees;
+    atomic_init(&alloc->owner_thread, pthread_self());
+    atomic_init(&alloc->remote_frees, NULL);
+    alloc->use_maintenance_thread = config.use_maintenance_thread;
+    alloc->maintenance_interval_ms = config.maintenance_interval_ms;
+    alloc->maintenance_stop = false;
+
+    alloc->huge_threshold = config.huge_threshold;
+    pointer_index_init(&alloc->huge_blocks, NULL, 0);
+    pthread_mutex_init(&alloc->huge_lock, NULL);
+
+    alloc->trim_threshold = config.trim_threshold;
+    alloc->trim_decay_ms = config.trim_decay_ms;
+    alloc->freed_since_trim = 0;
+    alloc->last_trim_ms = monotonic_ms();
+
+    // The extents only hand out memory, the first Allocator holds the caches
+    alloc->use_extents = config.use_extents;
+    alloc->extent_config = config;
+    alloc->extent_config.use_thread_cache = false;
+    alloc->extent_config.use_central_bins = false;
+    alloc->extent_config.use_cpu_cache = false;
+    alloc->extent_config.use_remote_frees = false;
+    alloc->extent_config.use_maintenance_thread = false;
+    alloc->extent_config.use_extents = false;
+    alloc->extent_config.huge_threshold = 0;
+    atomic_init(&alloc->next_extent, NULL);
+
+    if (config.use_slabs) {
+
+        // Increase the reserved pool to accommodate for the SlabCache and its page map
+        alloc->reserved_pool_border -= slab_cache_size;
+        alloc->reserved_pool_size += slab_cache_size;
+
+        SlabCache* cache = (SlabCache*) alloc->reserved_pool_border;
+        Slab** page_map = (Slab**) (alloc->reserved_pool_border + align_size(sizeof(SlabCache)));
+        slab_cache_init(cache, page_map, page_count, heap_start);
+
+        alloc->slabs = cache;
+
+    }
+
+    if (config.use_cpu_cache) {
+
+        // Increase the reserved pool to accommodate for the CpuCaches
+        alloc->reserved_pool_border -= cpu_cache_size;
+        alloc->reserved_pool_size += cpu_cache_size;
+
+        alloc->cpu_caches = (CpuCache*) alloc->reserved_pool_border;
+
+        for (size_t i = 0; i < cpu_cache_count; i++) {
+
+            pthread_mutex_init(&alloc->cpu_caches[i].lock, NULL);
+            tcache_init(&alloc->cpu_caches[i].bins);
+
+        }
+
+    }
+
+    if (config.engine == TLSF_ENGINE) {
+
+        // Increase the reserved pool to accommodate for the TlsfControl
+        alloc->reserved_pool_border -= align_size(sizeof(TlsfControl));
+        alloc->reserved_pool_size += align_size(sizeof(TlsfControl));
+
+        alloc->tlsf = (TlsfControl*) alloc->reserved_pool_border;
+
+        // The rest of the managed heap is the user pool
+        if (!tlsf_init(alloc->tlsf, heap_start, alloc->reserved_pool_border - heap_start)) {
+
+            destroy_allocator_locks(alloc);
+            return NULL;
+
+        }
+
+        start_maintenance_thread(alloc);
+        return alloc;
+
+    } else if (config.engine == BUDDY_ENGINE) {
+
+        // Increase the reserved pool to accommodate for the BuddyControl
+        alloc->reserved_pool_border -= align_size(sizeof(BuddyControl));
+        alloc->reserved_pool_size += align_size(sizeof(BuddyControl));
+
+        alloc->buddy = (BuddyControl*) alloc->reserved_pool_border;
+
+        // The rest of the managed heap is the user pool
+        if (!buddy_init(alloc->buddy, heap_start, alloc->reserved_pool_border - heap_start)) {
+
+            destroy_allocator_locks(alloc);
+            return NULL;
+
+        }
+
+        start_maintenance_thread(alloc);
+        return alloc;
+
+    }
+
+    /*
+     * Set the Allocator being used to let Allocator functions
+     * know which Allocator object to process.
+     *
+     * Also, store the current Allocator during the
+     * creation of this new Allocator to be able to set it
+     * back at the end of this function.
+     */
+    Allocator* stored_alloc = current_alloc;
+    set_allocator(alloc);
+
+    // Increase the reserved pool to accommodate for the LinkedList
+    alloc->reserved_pool_border -= align_size(sizeof(LinkedList));
+    alloc->reserved_pool_size += align_size(sizeof(LinkedList));
+
+    // Initialize LinkedList object
+    LinkedList* list = (LinkedList*) alloc->reserved_pool_border;
+
+    // Set LinkedList member variables
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->next_id = 0;
+
+    // Set Allocator member variable
+    alloc->list = list;
+
+    // Increase the reserved pool to accommodate for the pointer index
+    alloc->reserved_pool_border -= index_size;
+    alloc->reserved_pool_size += index_size;
+
+    // Initialize the pointer index
+    PointerIndexEntry* entries = (PointerIndexEntry*) alloc->reserved_pool_border;
+
+    if (source == HEAP_MMAP) {
+
+        // Fresh anonymous pages read as zero, leave the empty entries uncommitted
+        pointer_index_init_zeroed(&alloc->pointer_index, entries, index_capacity);
+
+    } else {
+
+        pointer_index_init(&alloc->pointer_index, entries, index_capacity);
+
+    }
+
+    // Initialize a Node referencing the entire user memory pool
+    void* memory_start = heap_start;
+
+    // Increase the reserved pool to accommodate for the MemoryData
+    alloc->reserved_pool_border -= align_size(sizeof(MemoryData));
+    alloc->reserved_pool_size += align_size(sizeof(MemoryData));
+
+    MemoryData* data = (MemoryData*) alloc->reserved_pool_border;
+
+    /*
+    * Set MemoryData member variables.
+    *
+    * In determining the size of the initial user pool we also account
+    * for the Node which will be created and stored in the reserved pool.
+    * Therefore, we subtract the size of Node in the initial user pool.
+    */
+    size_t block_size =
+        heap_size
+        - alloc->reserved_pool_size
+        - align_size(sizeof(Node));
+    bool is_free = true;
+    data->memory_start = memory_start;
+    data->block_size = block_size;
+    data->is_free = is_free;
+    data->in_use = true;
+    data->prev_free = NULL;
+    data->next_free = NULL;
+
+    // Increase the reserved pool to accommodate for the Node
+    alloc->reserved_pool_border -= align_size(sizeof(Node));
+    alloc->reserved_pool_size += align_size(sizeof(Node));
+
+    // Create Node containing the MemoryData
+    Node* node = (Node*) alloc->reserved_pool_border;
+
+    // Set Node member variables
+    node->data_size = align_size(sizeof(MemoryData));
+    node->next = NULL;
+    node->prev = NULL;
+    node->id = 0;
+    node->data = (void*) data;
+
+    add(list, node);
+    write_boundary_tags(node);
+
+    // The initial memory block is free, make it available for allocation
+    free_index_insert(node);
+
+    // Set the Allocator back to the one before this new Allocator
+    set_allocator(stored_alloc);
+
+    start_maintenance_thread(alloc);
+    return alloc;
+}
+
+/*
+ * @brief Retrieve the size of a page of the system.
+ *
+ * @return The page size in bytes.
+ */
+size_t system_page_size() {
+
+    return (size_t) sysconf(_SC_PAGESIZE);
+
+}
+
+/*
+ * @brief Create an Allocator managing anonymous memory mapped with
+ * mmap(). The pages are neither committed nor backed by swap until
+ * they are touched.
+ *
+ * @param1 The size of the managed heap, rounded up to whole pages.
+ * @param2 The options of the Allocator.
+ * @return The Allocator, or NULL if it could not be created.
+ */
+Allocator* create_mapped_allocator(size_t heap_size, AllocatorConfig config) {
+
+    size_t page_size = system_page_size();
+
+    if (heap_size > SIZE_MAX - page_size) { return NULL; }
+
+    heap_size = (heap_size + page_size - 1) / page_size * page_size;
+
+    void* heap_start = mmap(NULL, heap_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (heap_start == MAP_FAILED) { return NULL; }
+
+    Allocator* alloc = create_allocator_in((char*) heap_start, heap_size, config, HEAP_MMAP);
+
+    if (alloc == NULL) { munmap(heap_start, heap_size); }
+
+    return alloc;
+
+}
+
+Allocator* create_allocator_with_config(size_t heap_size, AllocatorConfig config) {
+
+    if (config.use_mmap) { return create_mapped_allocator(heap_size, config); }
+
+    // Realign to a factor of 8 for memory efficency
+    heap_size = align_size(heap_size);
+
+    // Utilize the built-in C malloc to acquire the managed heap
+    char* heap_start = (char*) malloc(heap_size);
+
+    if (heap_start == NULL) {
+
+        // Memory error from malloc()
+        return NULL;
+
+    }
+
+    Allocator* alloc = create_allocator_in(heap_start, heap_size, config, HEAP_MALLOC);
+
+    if (alloc == NULL) { free(heap_start); }
+
+    return alloc;
+
+}
+
+/*
+ * @brief Map 'size' bytes of a shared memory object at exactly
+ * 'address', failing rather than replacing an existing mapping.
+ *
+ * @param1 The file descriptor of the shared memory object.
+ * @param2 The address to map the shared memory object at.
+ * @param3 The size of the mapping.
+ * @return Whether the shared memory object was mapped at 'address'.
+ */
+bool map_shared_heap(int descriptor, void* address, size_t size) {
+
+    void* mapping = mmap(address, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED_NOREPLACE, descriptor, 0);
+
+    if (mapping == MAP_FAILED) { return false; }
+
+    if (mapping != address) {
+
+        // Kernels without MAP_FIXED_NOREPLACE treat the address as a hint
+        munmap(mapping, size);
+        return false;
+
+    }
+
+    return true;
+
+}
+
+Allocator* create_shared_allocator(const char* name, void* address, size_t heap_size, AllocatorConfig config) {
+
+    // Realign to a factor of 8 for memory efficency
+    heap_size = align_size(heap_size);
+
+    if (name == NULL || strlen(name) >= SHARED_NAME_SIZE || config.placement_ops) {
+
+        // Custom placement callbacks differ between processes
+        return NULL;
+
+    }
+
+    // Only the options without state private to a process are available
+    config.use_thread_cache = false;
+    config.use_cpu_cache = false;
+    config.use_remote_frees = false;
+    config.use_maintenance_thread = false;
+    config.use_mmap = false;
+    config.use_extents = false;
+    config.huge_threshold = 0;
+
+    int descriptor = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (descriptor < 0) { return NULL; }
+
+    if (ftruncate(descriptor, heap_size) != 0 || !map_shared_heap(descriptor, address, heap_size)) {
+
+        close(descriptor);
+        shm_unlink(name);
+        return NULL;
+
+    }
+
+    // The mapping stays valid after closing the file descriptor
+    close(descriptor);
+
+    Allocator* alloc = create_allocator_in((char*) address, heap_size, config, HEAP_SHARED);
+
+    if (alloc == NULL) {
+
+        munmap(address, heap_size);
+        shm_unlink(name);
+        return NULL;
+
+    }
+
+    strcpy(alloc->shared_name, name);
+
+    return alloc;
+
+}
+
+Allocator* attach_shared_allocator(const char* name) {
+
+    int descriptor = shm_open(name, O_RDWR, 0);
+
+    if (descriptor < 0) { return NULL; }
+
+    struct stat status;
+
+    if (fstat(descriptor, &status) != 0 || (size_t) status.st_size < sizeof(Allocator)) {
+
+        close(descriptor);
+        return NULL;
+
+    }
+
+    size_t heap_size = (size_t) status.st_size;
+
+    // The Allocator at the top of the heap tells the address it was created at
+    Allocator* probe = (Allocator*) mmap(NULL, heap_size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+    if (probe == MAP_FAILED) {
+
+        close(descriptor);
+        return NULL;
+
+    }
+
+    Allocator* top = (Allocator*) ((char*) probe + heap_size - align_size(sizeof(Allocator)));
+    char* heap_start = top->heap_start;
+    munmap(probe, heap_size);
+
+    bool mapped = map_shared_heap(descriptor, heap_start, heap_size);
+    close(descriptor);
+
+    if (!mapped) { return NULL; }
+
+    return (Allocator*) (heap_start + heap_size - align_size(sizeof(Allocator)));
+
+}
+
+void detach_shared_allocator(Allocator* alloc) {
+
+    if (alloc == NULL || alloc->heap_source != HEAP_SHARED) { return; }
+
+    if (current_alloc == alloc) { current_alloc = NULL; }
+
+    munmap(alloc->heap_start, alloc->heap_size);
+
+}
+
+size_t allocator_offset(Allocator* alloc, void* ptr) {
+
+    return (char*) ptr - alloc->heap_start;
+
+}
+
+void* allocator_pointer(Allocator* alloc, size_t offset) {
+
+    return alloc->heap_start + offset;
+
+}
+
+char* retrieve_user_pool_border() {
+
+    if (!current_alloc) { return NULL; }
+
+    Node* tail = current_alloc->list->tail;
+
+    if (!tail) {
+
+        // There are no memory blocks, the user pool is empty
+        return current_alloc->heap_start;
+
+    }
+
+    MemoryData* tail_data = (MemoryData*) tail->data;
+
+    /*
+     * The LinkedList is kept sorted by memory address and the memory
+     * blocks cover the whole user pool, thus the tail memory block
+     * always ends at the reserved pool border. If the
+     * tail memory block is free, the user pool border is its start.
+     */
+    if (tail_data->is_free) {
+
+        return tail_data->memory_start;
+
+    }
+
+    return tail_data->memory_start + tail_data->block_size;
+
+}
+
+/*
+ * @brief Determines if the user pool and reserved pool will
+ * overlap if we increase one of the borders by 'increase'.
+ *
+ * @note Since the pools are dual of each other, it does not
+ * matter if we choose to increase the user pool or the
+ * reserved pool. If an overlap happens, it will happen
+ * regardless of the pool we choose to increase.
+ *
+ * This check has no side effects. Cleansing the pools moves
+ * metadata Nodes around, which would invalidate the Nodes held
+ * by the caller. Therefore, cleansing is left to the slow path
+ * of allocator_malloc().
+ *
+ * @param The amount in bytes that we want to increase a pool.
+ * @return Whether the pools overlap or not.
+ */
+bool pool_overlap(size_t increase) {
+
+    if (!current_alloc) { return false; }
+
+    LinkedList* list = current_alloc->list;
+
+    if (list->size == 0) {
+
+        /*
+         * The list is empty, thus there can be no overlap.
+         */
+
+        return false;
+
+    }
+
+    // Retrieve the memory pool borders
+    char* user_border = retrieve_user_pool_border();
+    char* reserved_border = current_alloc->reserved_pool_border;
+
+    /*
+     * Check if the pools overlap if we increase one of the pools.
+     * Note that the choice of pool to increase is arbitrary as
+     * they are the dual of each other. The tail memory block has
+     * to keep at least MIN_BLOCK_SIZE bytes.
+     */
+    if (user_border + increase + MIN_BLOCK_SIZE > reserved_border) {
+
+        // The pool borders have reached each other, heap is considered full
+        return true;
+
+    }
+
+    return false;
+
+}
+
+bool increase_reserved_pool(size_t increase) {
+
+    // Make sure it is aligned to a factor of 8
+    increase = align_size(increase);
+
+    if (current_alloc == NULL || current_alloc->engine != LIST_ENGINE) {
+
+        // There is no Allocator to operate on or it has no metadata Nodes
+        return false;
+
+    }
+
+    if (pool_overlap(increase) == true) {
+
+        // There is an overlap, the heap is considered full
+        return false;
+
+    }
+
+    /*
+     * Need to also take away from the tail Node
+     * because that is where we take memory from when
+     * increasing the reserved pool border. Note that
+     * pool_overlap() has sorted the list and made sure
+     * that the tail memory block is free.
+     */
+    Node* tail = current_alloc->list->tail;
+    MemoryData* tail_data = (MemoryData*) tail->data;
+
+    // Shift the border of the reserved pool downwards
+    current_alloc->reserved_pool_border -= increase;
+    current_alloc->reserved_pool_size += increase;
+
+    // The tail changes size, reinsert it into the free memory block index
+    free_index_remove(tail);
+    tail_data->block_size -= increase;
+    write_boundary_tags(tail);
+    free_index_insert(tail);
+
+    return true;
+
+}
+
+/*
+ * @brief Decrease the reserved pool by 'decrease' and hand the
+ * memory back to the free tail memory block of the user pool.
+ *
+ * @param The amount to decrease the reserved pool.
+ */
+void decrease_reserved_pool(size_t decrease) {
+
+    Node* tail = current_alloc->list->tail;
+    MemoryData* tail_data = (MemoryData*) tail->data;
+
+    // Shift the border of the reserved pool upwards
+    current_alloc->reserved_pool_border += decrease;
+    current_alloc->reserved_pool_size -= decrease;
+
+    // The tail changes size, reinsert it into the free memory block index
+    free_index_remove(tail);
+    tail_data->block_size += decrease;
+    write_boundary_tags(tail);
+    free_index_insert(tail);
+
+}
+
+/*
+ * @brief Initialize an empty metadata Node in the reserved pool.
+ * The Node is placed at 'location' with its MemoryData directly
+ * above it, see cleanse_reserved_pool().
+ *
+ * @param Memory location of the metadata Node.
+ * @return The initialized metadata Node.
+ */
+Node* place_metadata_node(char* location) {
+
+    Node* node = (Node*) location;
+    MemoryData* data = (MemoryData*) (location + align_size(sizeof(Node)));
+
+    // Set MemoryData member variables
+    data->memory_start = NULL;
+    data->block_size = 0;
+    data->is_free = false;
+    data->in_use = true;
+    data->prev_free = NULL;
+    data->next_free = NULL;
+
+    // Set Node member variables
+    node->data_size = align_size(sizeof(MemoryData));
+    node->next = NULL;
+    node->prev = NULL;
+    node->id = 0;
+    node->data = (void*) data;
+
+    return node;
+
+}
+
+/*
+ * @brief Whether the metadata Node occupying the reserved pool
+ * memory at 'meta_data_node' is in use by the LinkedList.
+ *
+ * @param Memory location of the metadata Node.
+ * @return Whether the metadata Node is in use.
+ */
+bool meta_data_node_in_use(char* meta_data_node) {
+
+    MemoryData* data = (MemoryData*) (meta_data_node + align_size(sizeof(Node)));
+
+    return data->in_use;
+
+}
+
+/*
+ * @brief Push a vacant metadata Node on the stack of vacant slots,
+ * linked through the next and prev references of the Nodes.
+ *
+ * @param The vacant metadata Node, no longer part of the LinkedList.
+ */
+void push_vacant_slot(Node* node) {
+
+    Node* head = current_alloc->vacant_slots;
+
+    node->next = head;
+    node->prev = NULL;
+
+    if (head) {
+
+        head->prev = node;
+
+    }
+
+    current_alloc->vacant_slots = node;
+
+}
+
+/*
+ * @brief Unlink a vacant metadata Node from anywhere in the stack
+ * of vacant slots.
+ *
+ * @param The vacant metadata Node.
+ */
+void remove_vacant_slot(Node* node) {
+
+    if (node->prev) {
+
+        node->prev->next = node->next;
+
+    } else {
+
+        current_alloc->vacant_slots = node->next;
+
+    }
+
+    if (node->next) {
+
+        node->next->prev = node->prev;
+
+    }
+
+}
+
+/*
+ * @brief Collect every vacant metadata Node above the reserved pool
+ * border on the stack of vacant slots, after cleansing has moved
+ * the metadata Nodes around.
+ */
+void rebuild_vacant_slots() {
+
+    current_alloc->vacant_slots = NULL;
+
+    char* top_meta_data_node = current_alloc->heap_end - current_alloc->initial_reserved_pool_size;
+
+    for (
+        char* meta_data_node = current_alloc->reserved_pool_border;
+        meta_data_node < top_meta_data_node;
+        meta_data_node += current_alloc->meta_data_node_size
+    ) {
+
+        if (!meta_data_node_in_use(meta_data_node)) {
+
+            push_vacant_slot((Node*) meta_data_node);
+
+        }
+
+    }
+
+}
+
+/*
+ * @brief Reserve a single metadata Node and initialize it as an empty
+ * Node. A vacant metadata Node is reused if there is one, otherwise
+ * the reserved pool border is shifted to make room.
+ *
+ * @return The reserved metadata Node, or NULL if the heap is full.
+ */
+Node* reserve_metadata_node() {
+
+    Node* slot = current_alloc->vacant_slots;
+
+    if (slot) {
+
+        remove_vacant_slot(slot);
+        return place_metadata_node((char*) slot);
+
+    }
+
+    // Increase the reserved pool to accommodate for the metadata Node
+    if (!increase_reserved_pool(current_alloc->meta_data_node_size)) {
+
+        return NULL;
+
+    }
+
+    return place_metadata_node(current_alloc->reserved_pool_border);
+
+}
+
+Node* create_metadata_node(char* memory_start, size_t block_size, bool is_free) {
+
+    // Realign to a factor of 8 for memory efficency
+    block_size = align_size(block_size);
+
+    if (current_alloc == NULL || memory_start == NULL) {
+
+        // There is no Allocator to work on or function argument missing!
+        return NULL;
+
+    }
+
+    Node* node = reserve_metadata_node();
+
+    if (!node) {
+
+        // There is no room left for the metadata Node
+        return NULL;
+
+    }
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    // Set MemoryData member variables
+    data->memory_start = memory_start;
+    data->block_size = block_size;
+    data->is_free = is_free;
+
+    return node;
+
+}
+
+Node* merge_meta_data_nodes(LinkedList* list, Node* left_node, Node* right_node) {
+
+    if (list == NULL || left_node == NULL || right_node == NULL) {
+
+        // Function argument(s) missing
+        return NULL;
+
+    }
+
+    MemoryData* left_data = left_node->data;
+    MemoryData* right_data = right_node->data;
+
+    // Check that the 'left_node' is left adjacent to 'right_node'
+    if (left_data->memory_start + left_data->block_size != right_data->memory_start) {
+
+        return NULL;
+
+    }
+
+    // Free Nodes leave the free memory block index as the merge changes their size
+    if (left_data->is_free) { free_index_remove(left_node); }
+    if (right_data->is_free) { free_index_remove(right_node); }
+
+    // merge the block sizes
+    left_data->block_size += right_data->block_size;
+    write_boundary_tags(left_node);
+
+    // Mark the right Node as vacant
+    right_data->in_use = false;
+    right_data->is_free = true;
+
+    /*
+     * Remove the discarded Node from the LinkedList. The
+     * Node is unlinked through its previous and next
+     * references, so no traversal of the list is needed.
+     */
+    remove_node(list, right_node);
+    push_vacant_slot(right_node);
+
+    // Reinsert the merged Node with its new size
+    if (left_data->is_free) { free_index_insert(left_node); }
+
+    return left_node;
+
+}
+
+// What trim_range() releases the pages of, and what it has released
+typedef struct {
+
+    size_t min_size;
+    size_t released;
+
+} TrimState;
+
+/*
+ * @brief Release the whole pages within the range of a free memory
+ * block to the system. The pages read as zero once touched again.
+ *
+ * @param1 The start of the range, holding no metadata.
+ * @param2 The end of the range.
+ * @param3 The TrimState.
+ */
+void trim_range(char* start, char* end, void* context) {
+
+    TrimState* state = (TrimState*) context;
+
+    if (end <= start || (size_t) (end - start) < state->min_size) { return; }
+
+    size_t page_size = system_page_size();
+    uintptr_t first_page = ((uintptr_t) start + page_size - 1) / page_size * page_size;
+    uintptr_t last_page = (uintptr_t) end / page_size * page_size;
+
+    if (last_page <= first_page) { return; }
+
+    if (madvise((void*) first_page, last_page - first_page, MADV_DONTNEED) == 0) {
+
+        state->released += last_page - first_page;
+
+    }
+
+}
+
+/*
+ * @brief Release the pages of the free memory blocks of at least
+ * 'min_size' bytes of the Allocator pointed to by 'current_alloc'.
+ * The lock of the Allocator has to be held.
+ *
+ * @param The least size of the free memory blocks to release.
+ * @return The number of bytes released.
+ */
+size_t trim_free_blocks(size_t min_size) {
+
+    TrimState state = { min_size, 0 };
+
+    current_alloc->freed_since_trim = 0;
+    current_alloc->last_trim_ms = monotonic_ms();
+
+    if (current_alloc->heap_source == HEAP_SHARED) {
+
+        // Discarding pages of a shared mapping does not release them
+        return 0;
+
+    }
+
+    if (current_alloc->engine == TLSF_ENGINE) {
+
+        tlsf_for_each_free(current_alloc->tlsf, trim_range, &state);
+
+    } else if (current_alloc->engine == BUDDY_ENGINE) {
+
+        buddy_for_each_free(current_alloc->buddy, trim_range, &state);
+
+    } else {
+
+        LinkedListIterator iter;
+        iter.current = get_head(current_alloc->list);
+
+        while (has_next(&iter)) {
+
+            MemoryData* data = next(&iter)->data;
+
+            // The boundary tags stay in place
+            if (data->is_free) {
+
+                trim_range(data->memory_start + TAG_SIZE,
+                    data->memory_start + data->block_size - TAG_SIZE, &state);
+
+            }
+
+        }
+
+    }
+
+    return state.released;
+
+}
+
+/*
+ * @brief Account for a freed memory block, releasing the pages of
+ * the free memory blocks once 'trim_threshold' bytes have been freed
+ * and 'trim_decay_ms' have passed since the last release. The lock
+ * of the Allocator has to be held.
+ *
+ * @param The size of the freed memory block.
+ */
+void trim_after_free(size_t size) {
+
+    if (current_alloc->trim_threshold == 0) { return; }
+
+    current_alloc->freed_since_trim += size;
+
+    if (current_alloc->freed_since_trim < current_alloc->trim_threshold) { return; }
+
+    // Memory freed and reused in quick succession is not released in between
+    if (monotonic_ms() - current_alloc->last_trim_ms < current_alloc->trim_decay_ms) { return; }
+
+    trim_free_blocks(current_alloc->trim_threshold);
+
+}
+
+size_t allocator_trim() {
+
+    if (current_alloc == NULL) { return 0; }
+
+    Allocator* alloc = current_alloc;
+    size_t released = 0;
+
+    // The extents are trimmed along with the Allocator
+    while (current_alloc) {
+
+        acquire_lock(&current_alloc->lock);
+        released += trim_free_blocks(0);
+        pthread_mutex_unlock(&current_alloc->lock);
+
+        current_alloc = alloc->use_extents
+            ? atomic_load_explicit(&current_alloc->next_extent, memory_order_acquire)
+            : NULL;
+
+    }
+
+    current_alloc = alloc;
+
+    return released;
+
+}
+
+void cleanse_user_pool() {
+
+    if (current_alloc == NULL || current_alloc->engine != LIST_ENGINE) {
+
+        // There is no Allocator to operate on or no pool to cleanse
+        return;
+
+    }
+
+    acquire_lock(&current_alloc->lock);
+
+    LinkedList* list = current_alloc->list;
+
+    /*
+     * Go through the list and for each Node that
+     * has a free memory block, see if it is able to merge
+     * with the Node that comes after in the LinkedList.
+    */
+    LinkedListIterator iter;
+    iter.current = get_head(list);
+
+    while (has_next(&iter)) {
+
+        Node* node = next(&iter);
+        MemoryData* data = node->data;
+
+        if (data->is_free == false) {
+
+            // Only Nodes with free memory blocks can be merged
+            continue;
+
+        }
+
+        /*
+         * Keep merging with the next Node for as long as it
+         * has a free memory block.
+         */
+        Node* next_node = node->next;
+
+        while (next_node && ((MemoryData*) next_node->data)->is_free) {
+
+            if (!merge_meta_data_nodes(list, node, next_node)) {
+
+                // The memory blocks are not adjacent
+                break;
+
+            }
+
+            next_node = node->next;
+
+        }
+
+        // Continue after the merged Node
+        iter.current = node->next;
+
+    } // End while
+
+    // The merged free memory blocks are the ones most worth releasing
+    if (current_alloc->trim_threshold) { trim_free_blocks(current_alloc->trim_threshold); }
+
+    pthread_mutex_unlock(&current_alloc->lock);
+
+}
+
+void write_boundary_tags(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    // The header tag starts and the footer tag ends the memory block
+    *(Node**) data->memory_start = node;
+    *(Node**) (data->memory_start + data->block_size - TAG_SIZE) = node;
+
+}
+
+/*
+ * @brief Retrieve the metadata Node referenced by a boundary tag.
+ * The tag is only trusted if it references a metadata Node in
+ * use within the reserved pool, as a pointer not handed out by
+ * the Allocator leads to arbitrary memory being read as a tag.
+ *
+ * @param Memory location of the boundary tag.
+ * @return The referenced Node, or NULL if the tag is not valid.
+ */
+Node* read_boundary_tag(char* tag) {
+
+    char* meta_data_node = (char*) *(Node**) tag;
+
+    char* top_meta_data_node =
+        current_alloc->heap_end
+        - current_alloc->initial_reserved_pool_size;
+
+    // Check that the tag references a metadata Node location
+    if (
+        meta_data_node < current_alloc->reserved_pool_border ||
+        meta_data_node > top_meta_data_node ||
+        (size_t) (top_meta_data_node - meta_data_node) % current_alloc->meta_data_node_size != 0
+    ) {
+
+        return NULL;
+
+    }
+
+    if (!meta_data_node_in_use(meta_data_node)) {
+
+        return NULL;
+
+    }
+
+    return (Node*) meta_data_node;
+
+}
+
+/*
+ * @brief Add the Node of a memory block in use to the pointer index.
+ * If the pointer index is full, the Node is left unindexed.
+ *
+ * @param The Node of the memory block in use.
+ */
+void index_node(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (!pointer_index_insert(&current_alloc->pointer_index, data->memory_start, node)) {
+
+        // The Node can only be found through its header tag
+        current_alloc->unindexed_count++;
+
+    }
+
+}
+
+/*
+ * @brief Remove the Node of a memory block in use from the
+ * pointer index, as its memory block is about to be freed or moved.
+ *
+ * @param The Node of the memory block in use.
+ */
+void unindex_node(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (!pointer_index_remove(&current_alloc->pointer_index, data->memory_start)) {
+
+        // The Node was never indexed
+        current_alloc->unindexed_count--;
+
+    }
+
+}
+
+/*
+ * @details
+ * The pointer index holds the Nodes of every memory block in use,
+ * thus a pointer not handed out by the Allocator is rejected without
+ * reading memory around it. Only when the pointer index has been full,
+ * the Node may have to be found through the header tag instead.
+ */
+Node* retrieve_node(void* ptr) {
+
+    if (current_alloc == NULL || ptr == NULL) { return NULL; }
+
+    char* memory_start = (char*) ptr - TAG_SIZE;
+
+    Node* indexed_node = pointer_index_lookup(&current_alloc->pointer_index, memory_start);
+
+    if (indexed_node || current_alloc->unindexed_count == 0) {
+
+        return indexed_node;
+
+    }
+
+    // Check that the pointer lies within the user pool
+    if (
+        (char*) ptr < current_alloc->heap_start + TAG_SIZE ||
+        (char*) ptr >= current_alloc->reserved_pool_border ||
+        (size_t) (memory_start - current_alloc->heap_start) % 8 != 0
+    ) {
+
+        return NULL;
+
+    }
+
+    Node* node = read_boundary_tag(memory_start);
+
+    // The Node has to describe the memory block starting at the header tag
+    if (!node || ((MemoryData*) node->data)->memory_start != memory_start) {
+
+        return NULL;
+
+    }
+
+    return node;
+
+}
+
+/*
+ * @brief Retrieve the Node of the memory block physically
+ * preceding the memory block of 'node' through its footer tag.
+ *
+ * @param The Node.
+ * @return The left adjacent Node, or NULL if there is none.
+ */
+Node* retrieve_left_adjacent_node(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (data->memory_start == current_alloc->heap_start) {
+
+        // The memory block is the first in the user pool
+        return NULL;
+
+    }
+
+    return read_boundary_tag(data->memory_start - TAG_SIZE);
+
+}
+
+/*
+ * @brief Retrieve the Node of the memory block physically
+ * following the memory block of 'node' through its header tag.
+ *
+ * @param The Node.
+ * @return The right adjacent Node, or NULL if there is none.
+ */
+Node* retrieve_right_adjacent_node(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    char* memory_end = data->memory_start + data->block_size;
+
+    if (memory_end >= current_alloc->reserved_pool_border) {
+
+        // The memory block is the last in the user pool
+        return NULL;
+
+    }
+
+    return read_boundary_tag(memory_end);
+
+}
+
+/*
+ * @brief Move a metadata Node to the vacant reserved pool memory
+ * at 'destination' and update every reference to it.
+ *
+ * @param1 The metadata Node to move.
+ * @param2 Memory location of a vacant metadata Node.
+ * @return The Node at its new location.
+ */
+Node* relocate_metadata_node(Node* node, char* destination) {
+
+    LinkedList* list = current_alloc->list;
+    MemoryData* old_data = (MemoryData*) node->data;
+
+    // Copy the Node along with its MemoryData
+    memcpy(destination, node, current_alloc->meta_data_node_size);
+
+    Node* moved_node = (Node*) destination;
+    MemoryData* moved_data = (MemoryData*) (destination + align_size(sizeof(Node)));
+    moved_node->data = (void*) moved_data;
+
+    // The old location is no longer in use
+    old_data->in_use = false;
+
+    // The boundary tags have to reference the new location
+    write_boundary_tags(moved_node);
+
+    // So does the pointer index if the memory block is in use
+    PointerIndex* pointer_index = &current_alloc->pointer_index;
+    if (pointer_index_lookup(pointer_index, moved_data->memory_start) == node) {
+
+        pointer_index_insert(pointer_index, moved_data->memory_start, moved_node);
+
+    }
+
+    // Update the references of the LinkedList through both neighbours
+    if (moved_node->prev) {
+
+        moved_node->prev->next = moved_node;
+
+    } else {
+
+        list->head = moved_node;
+
+    }
+
+    if (moved_node->next) {
+
+        moved_node->next->prev = moved_node;
+
+    } else {
+
+        list->tail = moved_node;
+
+    }
+
+    // Update the references of the free memory block index
+    if (moved_data->is_free) {
+
+        current_placement()->relocate(current_alloc, node, moved_node);
+
+    }
+
+    return moved_node;
+
+}
+
+/*
+ * @brief Compact the reserved pool like cleanse_reserved_pool(), but
+ * in bounded steps. Every step moves the metadata Node at the border
+ * into a vacant slot, taken from the stack of vacant slots rather than
+ * searched for. The lock of the Allocator has to be held.
+ *
+ * @param The largest number of metadata Nodes to move.
+ * @return The number of metadata Nodes moved.
+ */
+size_t compact_reserved_pool(size_t budget) {
+
+    Node* tail = current_alloc->list->tail;
+
+    if (!tail || !((MemoryData*) tail->data)->is_free) {
+
+        // The released reserved pool memory can only be handed to a free tail memory block
+        return 0;
+
+    }
+
+    size_t meta_data_node_size = current_alloc->meta_data_node_size;
+    char* top_meta_data_node = current_alloc->heap_end - current_alloc->initial_reserved_pool_size;
+    size_t moved_count = 0;
+
+    while (true) {
+
+        // Release the vacant metadata Nodes that ended up at the border
+        while (
+            current_alloc->reserved_pool_border < top_meta_data_node &&
+            !meta_data_node_in_use(current_alloc->reserved_pool_border)
+        ) {
+
+            remove_vacant_slot((Node*) current_alloc->reserved_pool_border);
+            decrease_reserved_pool(meta_data_node_size);
+
+        }
+
+        if (moved_count == budget || current_alloc->vacant_slots == NULL) { break; }
+
+        // Every vacant slot lies above the border, which is in use
+        Node* slot = current_alloc->vacant_slots;
+        remove_vacant_slot(slot);
+
+        relocate_metadata_node((Node*) current_alloc->reserved_pool_border, (char*) slot);
+        decrease_reserved_pool(meta_data_node_size);
+
+        moved_count++;
+
+    }
+
+    return moved_count;
+
+}
+
+/*
+ * @details
+ * Loop through the metadata Nodes in the reserved pool
+ * from high memory to lower memory. If a metadata Node that is
+ * not in use is found, then move the metadata Node at the pool
+ * border to take its place and update the border pointer and
+ * reserved pool size. The memory released from the reserved
+ * pool is given to the free tail memory block.
+ *
+ * A metadata Node consits of a Node and a MemoryData object.
+ * Therefore, when going from high memory to lower memory, we
+ * have the order:
+ *
+ * HIGH MEMORY
+ *
+ * MemoryData
+ *
+ * Node
+ *
+ * LOW MEMORY.
+ */
+void cleanse_reserved_pool() {
+
+    if (current_alloc == NULL || current_alloc->engine != LIST_ENGINE) {
+
+        // There is no Allocator to operate on or no pool to cleanse
+        return;
+
+    }
+
+    acquire_lock(&current_alloc->lock);
+
+    Node* tail = current_alloc->list->tail;
+
+    if (!tail || !((MemoryData*) tail->data)->is_free) {
+
+        /*
+         * The released reserved pool memory can only be handed
+         * to a free tail memory block. There is nothing to gain.
+         */
+        pthread_mutex_unlock(&current_alloc->lock);
+        return;
+
+    }
+
+    // This will be the increments when doing metadata Node traversal
+    size_t meta_data_node_size = current_alloc->meta_data_node_size;
+
+    /*
+     * Memory location for the start of metadata Node traversal.
+     * Note that during Allocator creation, a metadata Node is
+     * created to accommodate for the memory block of the whole
+     * user pool. Thus, the first metadata Node is located at the
+     * initial reserved pool border during creation.
+     */
+    char* top_meta_data_node =
+        current_alloc->heap_end
+        - current_alloc->initial_reserved_pool_size;
+    char* meta_data_node = top_meta_data_node;
+
+    // Release the metadata Nodes at the border that are not in use
+    while (
+        current_alloc->reserved_pool_border < top_meta_data_node &&
+        !meta_data_node_in_use(current_alloc->reserved_pool_border)
+    ) {
+
+        decrease_reserved_pool(meta_data_node_size);
+
+    }
+
+    // Iterate through the metadata Nodes above the border
+    while (meta_data_node > current_alloc->reserved_pool_border) {
+
+        /*
+         * Check if we have found a Node that is not
+         * in use by the LinkedList.
+         */
+        if (!meta_data_node_in_use(meta_data_node)) {
+
+            // Move the border metadata Node to the vacant space
+            Node* border_node = (Node*) current_alloc->reserved_pool_border;
+            relocate_metadata_node(border_node, meta_data_node);
+
+            // Shift the border now that the border Node has been moved
+            decrease_reserved_pool(meta_data_node_size);
+
+            /*
+             * Release the metadata Nodes that are not in use that
+             * has now ended up at the border.
+             */
+            while (
+                current_alloc->reserved_pool_border < meta_data_node &&
+                !meta_data_node_in_use(current_alloc->reserved_pool_border)
+            ) {
+
+                decrease_reserved_pool(meta_data_node_size);
+
+            }
+
+        }
+
+        // Update traversal data
+        meta_data_node -= meta_data_node_size;
+
+    }
+
+    // The vacant metadata Nodes have been filled or released
+    rebuild_vacant_slots();
+
+    pthread_mutex_unlock(&current_alloc->lock);
+
+}
+
+/*
+ * @brief Create a residual Node from the original input Node.
+ * and update the original Node by discarding the memory block
+ * now given to the residual Node.
+ *
+ * @note The original Node must not be in the free memory block index, as its
+ * size changes.
+ *
+ * @param1 The Node to use to create the residual Node.
+ * @param2 The desired memory block size of the residual Node.
+ * @return A pointer to the residual Node.
+ */
+Node* create_residual_node(Node* node, size_t residual_size) {
+
+    // Realign to a factor of 8 for memory efficency
+    residual_size = align_size(residual_size);
+
+    if (!node || residual_size == 0) { return NULL; }
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (data->block_size <= residual_size) {
+
+        /*
+         * The size of the memory block of the residual Node has
+         * to be smaller than the block size of the original Node.
+         */
+        return NULL;
+
+    }
+
+    // The memory block size the original Node keeps
+    size_t kept_size = data->block_size - residual_size;
+
+    Node* residual_node = NULL;
+
+    if (node == current_alloc->list->tail && current_alloc->vacant_slots == NULL) {
+
+        /*
+         * The reserved pool takes its memory from the tail memory
+         * block. Since the original Node is the tail, the memory for
+         * the residual metadata Node is taken from the residual memory.
+         */
+        size_t meta_data_node_size = current_alloc->meta_data_node_size;
+
+        if (residual_size < meta_data_node_size + MIN_BLOCK_SIZE) {
+
+            return NULL;
+
+        }
+
+        // Shift the border of the reserved pool downwards
+        current_alloc->reserved_pool_border -= meta_data_node_size;
+        current_alloc->reserved_pool_size += meta_data_node_size;
+        data->block_size -= meta_data_node_size;
+
+        residual_node = place_metadata_node(current_alloc->reserved_pool_border);
+
+    } else {
+
+        residual_node = reserve_metadata_node();
+
+    }
+
+    if (!residual_node) {
+
+        // There is no room left for the residual metadata Node
+        return NULL;
+
+    }
+
+    /*
+     * Need to split up such that the residual memory is in a free Node.
+     * Note that the original Node may have shrunk while reserving
+     * the metadata Node if it is the tail.
+     */
+    MemoryData* residual_data = (MemoryData*) residual_node->data;
+    residual_data->memory_start = data->memory_start + kept_size;
+    residual_data->block_size = data->block_size - kept_size;
+    residual_data->is_free = true;
+
+    // Subtract the residual size from the original Node
+    data->block_size = kept_size;
+
+    write_boundary_tags(node);
+    write_boundary_tags(residual_node);
+
+    return residual_node;
+
+}
+
+/*
+ * @brief Allocate a memory block with the list engine.
+ *
+ * @param The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if the heap is full.
+ */
+void* list_malloc(size_t required_size) {
+
+    /*
+     * Realign to a factor of 8 for memory efficency and
+     * make room for the boundary tags.
+     */
+    required_size = align_size(required_size) + 2 * TAG_SIZE;
+
+    // Attempt to find a Node with an available memory block
+    Node* available_node = free_index_search(required_size);
+
+    if (available_node == NULL) {
+
+        /*
+         * No available Node was found, start pool cleansing
+         * to potentially reduce memory fragmentation and get
+         * more space.
+         */
+        cleanse_user_pool();
+        cleanse_reserved_pool();
+
+        // Try again to find an available memory block
+        available_node = free_index_search(required_size);
+
+        if (available_node == NULL) {
+
+            // The managed heap is full
+            return NULL;
+
+        }
+
+    }
+
+    /*
+     * A Node has been found. Take it out of the free memory block index and inspect
+     * the Node to see how to split up into allocated memory Node
+     * and residual memory Node.
+     */
+    free_index_remove(available_node);
+
+    // Retrieve Node data
+    MemoryData* available_data = (MemoryData*) available_node->data;
+    size_t node_block_size = available_data->block_size;
+
+    // Modify 'available_node' to reflect that it is now in use
+    available_data->is_free = false;
+    index_node(available_node);
+
+    if (node_block_size - required_size >= MIN_BLOCK_SIZE) {
+
+        /*
+         * Construct the residual metadata Node. If there is not
+         * enough space to create more metadata Nodes, the Node
+         * fits the size we want to allocate, so we use it as is.
+         */
+        size_t residual_memory_size = node_block_size - required_size;
+        Node* residual_node = create_residual_node(available_node, residual_memory_size);
+
+        if (residual_node) {
+
+            insert_after(current_alloc->list, available_node, residual_node);
+            free_index_insert(residual_node);
+
+        }
+
+    }
+
+    // Return the pointer to the allocated memory following the header tag
+    return available_data->memory_start + TAG_SIZE;
+
+}
+
+Node* naive_search(size_t size) {
+
+    // Realign to a factor of 8 for memory efficency
+    size = align_size(size);
+
+    // Loop through the LinkedList and find the first vacant memory block
+    LinkedListIterator iter;
+    iter.current = current_alloc->list->head;
+    Node* found_node = NULL;
+    while (has_next(&iter)) {
+
+        Node* node = next(&iter);
+        MemoryData* data = (MemoryData*) node->data;
+
+        if (data->is_free && size <= data->block_size) {
+
+            // A Node has been found
+            found_node = node;
+            break;
+
+        }
+
+    }
+
+    return found_node;
+
+}
+
+/*
+ * @brief Free a memory block handed out by the list engine.
+ *
+ * @details
+ * The Node of the pointer is found through the header tag in front
+ * of the pointer. The left adjacent Node is found through its footer
+ * tag right in front of the header tag, while the right adjacent Node
+ * is found through its header tag right after the footer tag.
+ *
+ * The Node that is to be set free should (if no bug has occured) at most
+ * merge with two Nodes, both being adjacent. Assuming this is not the case,
+ * say it merges with the right adjacent Node, and then this newly merged
+ * Node again merges with its right adjacent Node, then the two Nodes
+ * that was merged with the free Node should have been merged beforehand.
+ * Therefore, we can assume that is the case, thus we only have to do
+ * at most two merges.
+ *
+ * The right adjacent Node is merged with while the freed Node is still
+ * in use, after which the freed Node is put in the free memory block index.
+ * Merging with the left adjacent Node then keeps the index up to date by itself.
+ */
+void list_free(void* ptr) {
+
+    LinkedList* list = current_alloc->list;
+
+    // Retrieve the Node corresponding to 'ptr' through its header tag
+    Node* matched_node = retrieve_node(ptr);
+
+    if (!matched_node || ((MemoryData*) matched_node->data)->is_free) {
+
+       /*
+        * The corresponding Node was not found.
+        * the Allocator has not given out this pointer.
+        */
+        return;
+
+    }
+
+    MemoryData* matched_data = (MemoryData*) matched_node->data;
+    unindex_node(matched_node);
+
+    // See if the Node to be freed has adjacent free Nodes to merge with
+    Node* left_node = retrieve_left_adjacent_node(matched_node);
+    Node* right_node = retrieve_right_adjacent_node(matched_node);
+
+    if (right_node && ((MemoryData*) right_node->data)->is_free) {
+
+        merge_meta_data_nodes(list, matched_node, right_node);
+
+    }
+
+    // Mark the memory block as free and make it available for allocation
+    matched_data->is_free = true;
+    free_index_insert(matched_node);
+
+    if (left_node && ((MemoryData*) left_node->data)->is_free) {
+
+        /*
+         * Since merging results in the left Node remaining,
+         * 'matched_node' will be discarded from the list.
+         */
+        merge_meta_data_nodes(list, left_node, matched_node);
+
+    }
+
+}
+
+/*
+ * @brief Split off the memory after the first 'size' bytes of the
+ * memory block of the Node into a free residual Node, provided
+ * that the residual memory block is large enough.
+ *
+ * @param1 The Node to split up, must not be in the free memory block index.
+ * @param2 The memory block size the Node keeps.
+ */
+void trim_node(Node* node, size_t size) {
+
+    MemoryData* data = (MemoryData*) node->data;
+
+    if (data->block_size - size < MIN_BLOCK_SIZE) {
+
+        // The residual memory block is not worth keeping track of
+        return;
+
+    }
+
+    Node* residual_node = create_residual_node(node, data->block_size - size);
+
+    if (residual_node) {
+
+        insert_after(current_alloc->list, node, residual_node);
+        free_index_insert(residual_node);
+
+    }
+
+}
+
+/*
+ * @brief Reallocate a memory block handed out by the list engine.
+ *
+ * @param1 The pointer to the memory block.
+ * @param2 The desired size of the memory block.
+ * @return A pointer to the reallocated memory block, or NULL if it
+ * could not be reallocated.
+ */
+void* list_realloc(void* ptr, size_t size) {
+
+    // Realign to a factor of 8 for memory efficency
+    size = align_size(size);
+
+    /*
+     * Reallocating to a memory block of size 0
+     * is the same as freeing the memory block.
+     */
+    if (size == 0) { list_free(ptr); return NULL; }
+
+    LinkedList* list = current_alloc->list;
+
+    // Retrieve the Node corresponding to 'ptr' through its header tag
+    Node* ptr_node = retrieve_node(ptr);
+
+    // Check for corresponding pointer
+    if (!ptr_node) { return NULL; }
+
+    MemoryData* ptr_data = (MemoryData*) ptr_node->data;
+
+    // Check that it not already freed
+    if (ptr_data->is_free) { return NULL; }
+
+    // The memory block has to fit the boundary tags as well
+    size_t required_size = size + 2 * TAG_SIZE;
+
+    if (required_size == ptr_data->block_size) {
+
+        /*
+         * The function call has requested a realloc
+         * where the memory block size remains the same.
+         */
+        return ptr;
+
+    } else if (required_size < ptr_data->block_size) {
+
+        /*
+         * The function call has requested a trimming
+         * of the memory block. Create a Node for the freed memory.
+         */
+        trim_node(ptr_node, required_size);
+
+        return ptr;
+
+    }
+
+    /*
+     * The function call has requested an extension of the
+     * associated memory block.
+     */
+    size_t old_size = ptr_data->block_size - 2 * TAG_SIZE;
+
+    // Check if the adjacent Nodes are free
+    bool left_node_free = false;
+    bool right_node_free = false;
+    size_t left_node_size = 0;
+    size_t right_node_size = 0;
+
+    // Check if we can merge with the left adjacent Node
+    Node* prev_node = retrieve_left_adjacent_node(ptr_node);
+    if (prev_node) {
+
+        MemoryData* prev_data = (MemoryData*) prev_node->data;
+
+        if (prev_data->is_free) {
+
+            left_node_free = true;
+            left_node_size = prev_data->block_size;
+
+        }
+
+    }
+
+    // Check if we can merge with the right adjacent Node
+    Node* next_node = retrieve_right_adjacent_node(ptr_node);
+    if (next_node) {
+
+        MemoryData* next_data = (MemoryData*) next_node->data;
+
+        if (next_data->is_free) {
+
+            right_node_free = true;
+            right_node_size = next_data->block_size;
+
+        }
+
+    }
+
+    /*
+     * Evaluate the adjacent Nodes and determine if
+     * the merging of the memory blocks is sufficient
+     * for the size as requested in the function argument.
+     */
+    if (
+        right_node_free &&
+        ptr_data->block_size + right_node_size >= required_size
+    ) {
+
+        // Merging with the right Node is sufficient
+        Node* merged_node = merge_meta_data_nodes(list, ptr_node, next_node);
+
+        // Need to split up such that the residual memory is in a free node
+        trim_node(merged_node, required_size);
+
+        return ptr;
+
+    } else if (
+        left_node_free &&
+        ptr_data->block_size + left_node_size >= required_size
+    ) {
+
+        // Merging with the left Node is sufficient
+        unindex_node(ptr_node);
+        Node* merged_node = merge_meta_data_nodes(list, prev_node, ptr_node);
+        MemoryData* merged_data = (MemoryData*) merged_node->data;
+
+        /*
+         * Since merging keeps the left Node, which was free in this case,
+         * we need to set the newly merged Node to non-free.
+         */
+        free_index_remove(merged_node);
+        merged_data->is_free = false;
+        index_node(merged_node);
+
+        // Move the content to the start of the merged memory block
+        char* new_location = merged_data->memory_start + TAG_SIZE;
+        memmove(new_location, ptr, old_size);
+
+        // Need to split up such that the residual memory is in a free node
+        trim_node(merged_node, required_size);
+
+        return new_location;
+
+    } else if (
+        left_node_free &&
+        right_node_free &&
+        ptr_data->block_size + left_node_size + right_node_size >= required_size
+    ) {
+
+        // Merging with both the Nodes is sufficient
+        unindex_node(ptr_node);
+        Node* merged_node = merge_meta_data_nodes(list, ptr_node, next_node);
+        merged_node = merge_meta_data_nodes(list, prev_node, merged_node);
+
+        MemoryData* merged_data = (MemoryData*) merged_node->data;
+        /*
+         * Since merging keeps the left Node, which was free in this case,
+         * we need to set the newly merged Node to non-free.
+         */
+        free_index_remove(merged_node);
+        merged_data->is_free = false;
+        index_node(merged_node);
+
+        // Move the content to the start of the merged memory block
+        char* new_location = merged_data->memory_start + TAG_SIZE;
+        memmove(new_location, ptr, old_size);
+
+        // Need to split up such that the residual memory is in a free node
+        trim_node(merged_node, required_size);
+
+        return new_location;
+
+    } else {
 
         /*
-         * No free Node was found. This means that
-         * the heap is completely free.
+         * Merging with the adjacent Nodes are either
+         * not possible or not sufficient. Thus, we
+         * need to look for a new location on the
+         * managed heap.
          */
+
+        void* new_location = list_malloc(size);
+
+        if (!new_location) {
+
+            // The managed heap is full, the original is left untouched
+            return NULL;
+
+        }
+
+        /*
+        * Copy the memory data from the original and place it
+        * in the new location.
+        */
+        memcpy(new_location, ptr, old_size);
+
+        // Free the original Node as it is no longer in use
+        list_free(ptr);
+
+        return new_location;
+
+    }
+
+    return NULL;
+
+}
+
+/*
+ * @brief Retrieve the number of bytes usable at a pointer of the
+ * list engine, in between the boundary tags.
+ *
+ * @param The pointer to the memory block.
+ * @return The usable size, or 0 if 'ptr' is not in use.
+ */
+size_t list_usable_size(void* ptr) {
+
+    Node* ptr_node = retrieve_node(ptr);
+
+    if (!ptr_node) { return 0; }
+
+    MemoryData* ptr_data = (MemoryData*) ptr_node->data;
+
+    if (ptr_data->is_free) { return 0; }
+
+    return ptr_data->block_size - 2 * TAG_SIZE;
+
+}
+
+/*
+ * @brief Allocate a memory block with the engine of the Allocator,
+ * bypassing the slabs.
+ *
+ * @param The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if the heap is full.
+ */
+void* engine_malloc(size_t size) {
+
+    if (current_alloc->engine == TLSF_ENGINE) {
+
+        return tlsf_malloc(current_alloc->tlsf, size);
+
+    } else if (current_alloc->engine == BUDDY_ENGINE) {
+
+        return buddy_malloc(current_alloc->buddy, size);
+
+    }
+
+    return list_malloc(size);
+
+}
+
+/*
+ * @brief Free a memory block handed out by the engine of the Allocator.
+ *
+ * @param The pointer to the memory block.
+ */
+void engine_free(void* ptr) {
+
+    if (current_alloc->engine == TLSF_ENGINE) {
+
+        tlsf_free(current_alloc->tlsf, ptr);
+
+    } else if (current_alloc->engine == BUDDY_ENGINE) {
+
+        buddy_free(current_alloc->buddy, ptr);
+
+    } else {
+
+        list_free(ptr);
+
+    }
+
+}
+
+/*
+ * @brief Reallocate a memory block handed out by the engine of the Allocator.
+ *
+ * @param1 The pointer to the memory block.
+ * @param2 The desired size of the memory block.
+ * @return A pointer to the reallocated memory block, or NULL if it
+ * could not be reallocated.
+ */
+void* engine_realloc(void* ptr, size_t size) {
+
+    if (current_alloc->engine == TLSF_ENGINE) {
+
+        return tlsf_realloc(current_alloc->tlsf, ptr, size);
+
+    } else if (current_alloc->engine == BUDDY_ENGINE) {
+
+        return buddy_realloc(current_alloc->buddy, ptr, size);
+
+    }
+
+    return list_realloc(ptr, size);
+
+}
+
+/*
+ * @brief Retrieve the number of bytes usable at a pointer handed
+ * out by the engine of the Allocator.
+ *
+ * @param The pointer to the memory block.
+ * @return The usable size, or 0 if 'ptr' is not in use.
+ */
+size_t engine_usable_size(void* ptr) {
+
+    if (current_alloc->engine == TLSF_ENGINE) {
+
+        return tlsf_usable_size(current_alloc->tlsf, ptr);
+
+    } else if (current_alloc->engine == BUDDY_ENGINE) {
+
+        return buddy_usable_size(current_alloc->buddy, ptr);
+
+    }
+
+    return list_usable_size(ptr);
+
+}
+
+/*
+ * @brief Allocate a small object from the slabs, carving a new
+ * slab out of the user pool when every slab of its size class
+ * is full.
+ *
+ * @param The size of the object, at most SLAB_MAX_OBJECT_SIZE.
+ * @return A pointer to the object, or NULL if no slab could be created.
+ */
+void* slab_cache_malloc(size_t size) {
+
+    SlabCache* cache = current_alloc->slabs;
+    void* object = slab_malloc(cache, size);
+
+    if (object) { return object; }
+
+    char* memory = engine_malloc(SLAB_SIZE);
+
+    if (memory == NULL) {
+
+        // The heap has no room for another slab
+        return NULL;
+
+    }
+
+    slab_create(cache, memory, size);
+
+    return slab_malloc(cache, size);
+
+}
+
+/*
+ * @brief Allocate memory like allocator_malloc(), with the lock
+ * of the Allocator already held.
+ *
+ * @param The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if the heap is full.
+ */
+void* unlocked_malloc(size_t required_size) {
+
+    if (current_alloc->slabs && required_size <= SLAB_MAX_OBJECT_SIZE) {
+
+        void* object = slab_cache_malloc(required_size);
+
+        if (object) { return object; }
+
+    }
+
+    // Large objects, or small ones when no slab could be created
+    return engine_malloc(required_size);
+
+}
+
+/*
+ * @brief Free memory like allocator_free(), with the lock
+ * of the Allocator already held.
+ *
+ * @param The pointer to the memory block.
+ */
+void unlocked_free(void* ptr) {
+
+    Slab* slab = current_alloc->slabs ? slab_lookup(current_alloc->slabs, ptr) : NULL;
+
+    if (slab == NULL) {
+
+        size_t size = current_alloc->trim_threshold ? engine_usable_size(ptr) : 0;
+
+        engine_free(ptr);
+        trim_after_free(size);
+        return;
+
+    }
+
+    if (slab_free(current_alloc->slabs, slab, ptr)) {
+
+        // The slab became empty, hand its memory back to the engine
+        engine_free(slab);
+        trim_after_free(SLAB_SIZE);
+
+    }
+
+}
+
+/*
+ * @brief Reallocate memory like allocator_realloc(), with the lock
+ * of the Allocator already held.
+ *
+ * @param1 The pointer to the memory block.
+ * @param2 The desired size of the memory block.
+ * @return A pointer to the reallocated memory block, or NULL if it
+ * could not be reallocated.
+ */
+void* unlocked_realloc(void* ptr, size_t size) {
+
+    Slab* slab = current_alloc->slabs ? slab_lookup(current_alloc->slabs, ptr) : NULL;
+
+    if (slab == NULL) {
+
+        return engine_realloc(ptr, size);
+
+    }
+
+    if (!slab_occupied(slab, ptr)) {
+
+        // The Allocator has not given out this pointer
+        return NULL;
+
+    }
+
+    if (size == 0) { unlocked_free(ptr); return NULL; }
+
+    // The object stays in place for as long as it fits
+    if (size <= slab->object_size) { return ptr; }
+
+    void* new_location = unlocked_malloc(size);
+
+    if (!new_location) { return NULL; }
+
+    memcpy(new_location, ptr, slab->object_size);
+    unlocked_free(ptr);
+
+    return new_location;
+
+}
+
+/*
+ * @brief Retrieve the usable size like allocator_usable_size(), with
+ * the lock of the Allocator already held.
+ *
+ * @param The pointer to the memory block.
+ * @return The usable size, or 0 if 'ptr' is not in use.
+ */
+size_t unlocked_usable_size(void* ptr) {
+
+    Slab* slab = current_alloc->slabs ? slab_lookup(current_alloc->slabs, ptr) : NULL;
+
+    if (slab == NULL) { return engine_usable_size(ptr); }
+
+    return slab_occupied(slab, ptr) ? slab->object_size : 0;
+
+}
+
+/*
+ * @brief Free a chain of memory blocks through the engine, taking
+ * the lock of the Allocator once for the whole chain.
+ *
+ * @param1 The Allocator.
+ * @param2 The first memory block, linked to the next through its first word.
+ */
+void engine_free_chain(Allocator* alloc, void* chain) {
+
+    acquire_lock(&alloc->lock);
+
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
+
+    while (chain) {
+
+        void* next_ptr = *(void**) chain;
+        unlocked_free(tcache_header(chain));
+        chain = next_ptr;
+
+    }
+
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
+
+}
+
+/*
+ * @brief Hand a chain of cached memory blocks of a size class back,
+ * to the central bin of the size class if enabled, otherwise to the
+ * engine. A central bin above its high-water mark hands a batch on
+ * to the engine.
+ *
+ * @param1 The Allocator.
+ * @param2 The size class of the memory blocks.
+ * @param3 The first memory block, linked to the next through its first word.
+ */
+void release_cached_blocks(Allocator* alloc, size_t size_class, void* chain) {
+
+    if (!alloc->use_central_bins) {
+
+        engine_free_chain(alloc, chain);
+        return;
+
+    }
+
+    CentralBin* bin = &alloc->central_bins[size_class];
+    void* surplus = NULL;
+
+    acquire_lock(&bin->lock);
+
+    while (chain) {
+
+        void* next_ptr = *(void**) chain;
+        *(void**) chain = bin->stack;
+        bin->stack = chain;
+        bin->count++;
+        chain = next_ptr;
+
+    }
+
+    if (bin->count > CENTRAL_BIN_HIGH_WATER) {
+
+        // Take the surplus off the bin, but free it after releasing the bin
+        for (size_t i = 0; i < CENTRAL_BIN_BATCH; i++) {
+
+            void* ptr = bin->stack;
+            bin->stack = *(void**) ptr;
+            bin->count--;
+
+            *(void**) ptr = surplus;
+            surplus = ptr;
+
+        }
+
+    }
+
+    pthread_mutex_unlock(&bin->lock);
+
+    if (surplus) { engine_free_chain(alloc, surplus); }
+
+}
+
+/*
+ * @brief Take a memory block of a size class from its central bin,
+ * refilling the central bin from the engine when it is empty.
+ *
+ * @param1 The Allocator.
+ * @param2 The size class.
+ * @return The memory block, marked as cached, or NULL if the heap is full.
+ */
+void* central_bin_malloc(Allocator* alloc, size_t size_class) {
+
+    CentralBin* bin = &alloc->central_bins[size_class];
+
+    acquire_lock(&bin->lock);
+
+    void* ptr = bin->stack;
+
+    if (ptr) {
+
+        bin->stack = *(void**) ptr;
+        bin->count--;
+
+    }
+
+    pthread_mutex_unlock(&bin->lock);
+
+    if (ptr) { return ptr; }
+
+    // Allocate a whole batch from the engine while holding the lock of the Allocator
+    void* chain = NULL;
+
+    acquire_lock(&alloc->lock);
+
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
+
+    for (size_t i = 0; i < CENTRAL_BIN_REFILL; i++) {
+
+        TcacheHeader* header = unlocked_malloc(tcache_class_size(size_class) + TCACHE_HEADER_SIZE);
+
+        if (header == NULL) { break; }
+
+        header->size_class = size_class;
+        header->state = TCACHE_CACHED;
+
+        ptr = (char*) header + TCACHE_HEADER_SIZE;
+        *(void**) ptr = chain;
+        chain = ptr;
+
+    }
+
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
+
+    if (chain == NULL) { return NULL; }
+
+    // Keep the first memory block, the others go to the central bin
+    ptr = chain;
+    chain = *(void**) chain;
+
+    if (chain) { release_cached_blocks(alloc, size_class, chain); }
+
+    return ptr;
+
+}
+
+/*
+ * @brief Hand the memory blocks on top of a stack of the ThreadCache
+ * back to its Allocator.
+ *
+ * @param1 The ThreadCache.
+ * @param2 The size class of the stack.
+ * @param3 The number of memory blocks to hand back.
+ */
+void thread_cache_flush(ThreadCache* cache, size_t size_class, size_t count) {
+
+    void* chain = NULL;
+
+    for (size_t i = 0; i < count; i++) {
+
+        void* ptr = tcache_pop(&cache->bins, size_class);
+
+        if (ptr == NULL) { break; }
+
+        *(void**) ptr = chain;
+        chain = ptr;
+
+    }
+
+    if (chain) { release_cached_blocks(cache->owner, size_class, chain); }
+
+}
+
+/*
+ * @brief Hand every cached memory block back to the owner of the
+ * ThreadCache and remove the ThreadCache from its registry.
+ *
+ * @param The ThreadCache.
+ */
+void thread_cache_detach(ThreadCache* cache) {
+
+    Allocator* alloc = cache->owner;
+
+    if (alloc == NULL) { return; }
+
+    for (size_t i = 0; i < TCACHE_CLASS_COUNT; i++) {
+
+        thread_cache_flush(cache, i, cache->bins.counts[i]);
+
+    }
+
+    acquire_lock(&alloc->lock);
+
+    if (cache->prev) {
+
+        cache->prev->next = cache->next;
+
+    } else {
+
+        alloc->thread_caches = cache->next;
+
+    }
+
+    if (cache->next) {
+
+        cache->next->prev = cache->prev;
+
+    }
+
+    cache->owner = NULL;
+
+    pthread_mutex_unlock(&alloc->lock);
+
+}
+
+/*
+ * @brief Called when a thread exits, handing its cached memory
+ * blocks back.
+ *
+ * @param The ThreadCaches of the thread.
+ */
+void thread_cache_exit(void* caches) {
+
+    for (size_t i = 0; i < THREAD_CACHE_SLOTS; i++) {
+
+        thread_cache_detach(&((ThreadCache*) caches)[i]);
+
+    }
+
+}
+
+/*
+ * @brief Create the key handing back the ThreadCache of exiting threads.
+ */
+void thread_cache_key_create() {
+
+    pthread_key_create(&thread_cache_key, thread_cache_exit);
+
+}
+
+/*
+ * @brief Retrieve the ThreadCache of the thread caching the memory
+ * blocks of 'alloc'. Without one, a vacant ThreadCache is bound to
+ * 'alloc', or, once every ThreadCache is taken, the ThreadCaches take
+ * turns handing their memory blocks back to make room.
+ *
+ * @param The Allocator.
+ * @return The ThreadCache of 'alloc'.
+ */
+ThreadCache* thread_cache_bind(Allocator* alloc) {
+
+    ThreadCache* cache = NULL;
+
+    for (size_t i = 0; i < THREAD_CACHE_SLOTS; i++) {
+
+        if (thread_caches[i].owner == alloc) { return &thread_caches[i]; }
+
+        if (cache == NULL && thread_caches[i].owner == NULL) { cache = &thread_caches[i]; }
+
+    }
+
+    if (cache == NULL) {
+
+        cache = &thread_caches[thread_cache_victim];
+        thread_cache_victim = (thread_cache_victim + 1) % THREAD_CACHE_SLOTS;
+        thread_cache_detach(cache);
+
+    }
+
+    pthread_once(&thread_cache_key_once, thread_cache_key_create);
+    pthread_setspecific(thread_cache_key, thread_caches);
+
+    // Register the ThreadCache, such that destroying the Allocator detaches it
+    acquire_lock(&alloc->lock);
+
+    cache->prev = NULL;
+    cache->next = alloc->thread_caches;
+
+    if (cache->next) {
+
+        cache->next->prev = cache;
+
+    }
+
+    alloc->thread_caches = cache;
+    cache->owner = alloc;
+
+    pthread_mutex_unlock(&alloc->lock);
+
+    return cache;
+
+}
+
+/*
+ * @brief Take the CpuCache of the CPU the calling thread runs on.
+ *
+ * @param The Allocator.
+ * @return The locked CpuCache, or NULL if it is held by a thread
+ * that was running on the CPU before.
+ */
+CpuCache* cpu_cache_acquire(Allocator* alloc) {
+
+    int cpu = sched_getcpu();
+
+    // Fall back to a single CpuCache where the CPU is unknown
+    CpuCache* cache = &alloc->cpu_caches[cpu >= 0 ? (size_t) cpu % alloc->cpu_cache_count : 0];
+
+    if (!try_acquire_lock(&cache->lock)) { return NULL; }
+
+    return cache;
+
+}
+
+/*
+ * @brief Take a memory block of a size class from the CpuCache of
+ * the calling thread.
+ *
+ * @param1 The Allocator.
+ * @param2 The size class.
+ * @return The memory block, marked as cached, or NULL if the
+ * CpuCache is empty or busy.
+ */
+void* cpu_cache_malloc(Allocator* alloc, size_t size_class) {
+
+    CpuCache* cache = cpu_cache_acquire(alloc);
+
+    if (cache == NULL) { return NULL; }
+
+    void* ptr = tcache_pop(&cache->bins, size_class);
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return ptr;
+
+}
+
+/*
+ * @brief Push a memory block on the CpuCache of the calling thread.
+ * A batch is handed back once the stack of the size class is above
+ * its high-water mark.
+ *
+ * @param1 The Allocator.
+ * @param2 The size class of the memory block.
+ * @param3 The memory block, marked as cached.
+ * @return Whether the memory block was cached, false if the CpuCache is busy.
+ */
+bool cpu_cache_free(Allocator* alloc, size_t size_class, void* ptr) {
+
+    CpuCache* cache = cpu_cache_acquire(alloc);
+
+    if (cache == NULL) { return false; }
+
+    void* chain = NULL;
+
+    if (tcache_push(&cache->bins, size_class, ptr) > TCACHE_HIGH_WATER) {
+
+        // Take the batch off the CpuCache, but hand it back after releasing the CpuCache
+        for (size_t i = 0; i < TCACHE_FLUSH_BATCH; i++) {
+
+            void* cached = tcache_pop(&cache->bins, size_class);
+            *(void**) cached = chain;
+            chain = cached;
+
+        }
+
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    if (chain) { release_cached_blocks(alloc, size_class, chain); }
+
+    return true;
+
+}
+
+/*
+ * @brief Retrieve the header of a memory block handed out by an
+ * Allocator prefixing its memory blocks with a TcacheHeader.
+ *
+ * @param1 The Allocator.
+ * @param2 The pointer to verify.
+ * @return The TcacheHeader, or NULL if 'ptr' is not in use.
+ */
+TcacheHeader* block_header(Allocator* alloc, void* ptr) {
+
+    char* location = (char*) ptr;
+
+    if (location < alloc->heap_start + TCACHE_HEADER_SIZE || location >= alloc->heap_end) {
+
+        return NULL;
+
+    }
+
+    TcacheHeader* header = tcache_header(ptr);
+
+    // Cached memory blocks are not in use, they have been freed before
+    if (header->state != TCACHE_IN_USE || header->size_class > TCACHE_CLASS_COUNT) {
+
+        return NULL;
+
+    }
+
+    return header;
+
+}
+
+/*
+ * @brief Allocate memory from an Allocator prefixing its memory
+ * blocks with a TcacheHeader. Small memory blocks are taken from
+ * the ThreadCache, the CpuCache or the central bins when enabled.
+ *
+ * @param1 The Allocator.
+ * @param2 The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if the heap is full.
+ */
+void* headed_malloc(Allocator* alloc, size_t required_size) {
+
+    size_t size_class = tcache_class(required_size);
+    size_t block_size = required_size;
+
+    if (size_class < TCACHE_CLASS_COUNT) {
+
+        void* ptr = NULL;
+
+        if (alloc->use_thread_cache) {
+
+            ptr = tcache_pop(&thread_cache_bind(alloc)->bins, size_class);
+
+        }
+
+        if (ptr == NULL && alloc->use_cpu_cache) {
+
+            ptr = cpu_cache_malloc(alloc, size_class);
+
+        }
+
+        if (ptr == NULL && alloc->use_central_bins) {
+
+            ptr = central_bin_malloc(alloc, size_class);
+
+            if (ptr == NULL) { return NULL; }
+
+        }
+
+        if (ptr) {
+
+            tcache_header(ptr)->state = TCACHE_IN_USE;
+            return ptr;
+
+        }
+
+        // Round up, such that the memory block can be cached once freed
+        block_size = tcache_class_size(size_class);
+
+    } else if (required_size > SIZE_MAX - TCACHE_HEADER_SIZE) {
+
         return NULL;
 
     }
 
-    MemoryData* found_data = (MemoryData*) found_node->data;
+    acquire_lock(&alloc->lock);
+
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
+
+    TcacheHeader* header = unlocked_malloc(block_size + TCACHE_HEADER_SIZE);
+
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
+
+    if (header == NULL) { return NULL; }
+
+    header->size_class = size_class;
+    header->state = TCACHE_IN_USE;
+
+    return (char*) header + TCACHE_HEADER_SIZE;
+
+}
+
+/*
+ * @brief Free memory of an Allocator prefixing its memory blocks
+ * with a TcacheHeader. Small memory blocks are pushed on the
+ * ThreadCache, which hands a batch back once the stack of the size
+ * class is above its high-water mark, the CpuCache or the central bins.
+ *
+ * @param1 The Allocator.
+ * @param2 The pointer to the memory block.
+ */
+void headed_free(Allocator* alloc, void* ptr) {
+
+    TcacheHeader* header = block_header(alloc, ptr);
+
+    if (header == NULL) {
+
+        // Not a memory block in use, ignore it
+        return;
+
+    }
+
+    size_t size_class = header->size_class;
+
+    if (size_class == TCACHE_CLASS_COUNT) {
+
+        // Large memory blocks are never cached
+        header->state = 0;
+
+        *(void**) ptr = NULL;
+        engine_free_chain(alloc, ptr);
+        return;
+
+    }
+
+    header->state = TCACHE_CACHED;
+
+    if (!alloc->use_thread_cache) {
+
+        if (alloc->use_cpu_cache && cpu_cache_free(alloc, size_class, ptr)) { return; }
+
+        *(void**) ptr = NULL;
+        release_cached_blocks(alloc, size_class, ptr);
+        return;
+
+    }
+
+    ThreadCache* cache = thread_cache_bind(alloc);
+
+    if (tcache_push(&cache->bins, size_class, ptr) > TCACHE_HIGH_WATER) {
+
+        thread_cache_flush(cache, size_class, TCACHE_FLUSH_BATCH);
+
+    }
+
+}
+
+/*
+ * @brief Reallocate memory of an Allocator prefixing its memory
+ * blocks with a TcacheHeader. Small memory blocks stay in place
+ * while they fit their size class.
+ *
+ * @param1 The Allocator.
+ * @param2 The pointer to the memory block.
+ * @param3 The desired size of the memory block.
+ * @return A pointer to the reallocated memory block, or NULL if it
+ * could not be reallocated.
+ */
+void* headed_realloc(Allocator* alloc, void* ptr, size_t size) {
+
+    TcacheHeader* header = block_header(alloc, ptr);
+
+    if (header == NULL) { return NULL; }
+
+    if (size == 0) { headed_free(alloc, ptr); return NULL; }
+
+    if (header->size_class < TCACHE_CLASS_COUNT) {
+
+        size_t class_size = tcache_class_size(header->size_class);
+
+        if (size <= class_size) { return ptr; }
+
+        void* new_location = headed_malloc(alloc, size);
+
+        if (!new_location) { return NULL; }
+
+        memcpy(new_location, ptr, class_size);
+        headed_free(alloc, ptr);
+
+        return new_location;
+
+    }
+
+    if (size > SIZE_MAX - TCACHE_HEADER_SIZE) { return NULL; }
+
+    // Large memory blocks are never cached, the header moves along with the contents
+    acquire_lock(&alloc->lock);
+
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
+
+    char* new_header = unlocked_realloc(header, size + TCACHE_HEADER_SIZE);
+
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
+
+    return new_header ? new_header + TCACHE_HEADER_SIZE : NULL;
+
+}
+
+/*
+ * @brief Queue a free of another thread than the owner of the
+ * Allocator, without taking the lock.
+ *
+ * @param1 The Allocator.
+ * @param2 The pointer to the memory block.
+ */
+void push_remote_free(Allocator* alloc, void* ptr) {
+
+    char* location = (char*) ptr;
+
+    // Any pointer handed out lies aligned within the user pool
+    if (location < alloc->heap_start
+        || location >= alloc->heap_end - alloc->initial_reserved_pool_size
+        || (size_t) (location - alloc->heap_start) % 8 != 0) {
+
+        return;
+
+    }
+
+    void* head = atomic_load_explicit(&alloc->remote_frees, memory_order_relaxed);
 
-    // Retrieve the memory pool borders
-    char* user_border = found_data->memory_start + found_data->block_size;
+    do {
+
+        *(void**) ptr = head;
 
-    return user_border;
+    } while (!atomic_compare_exchange_weak_explicit(&alloc->remote_frees, &head, ptr,
+        memory_order_release, memory_order_relaxed));
 
 }
 
 /*
- * @brief Determines if the user pool and reserved pool will
- * overlap if we increase one of the borders by 'increase'.
- *
- * @note Since the pools are dual of each other, it does not
- * matter if we choose to increase the user pool or the
- * reserved pool. If an overlap happens, it will happen
- * regardless of the pool we choose to increase.
+ * @brief Free the memory blocks queued by other threads than the
+ * owner, taking the whole stack at once.
  *
- * @param The amount in bytes that we want to increase a pool.
- * @return Whether the pools overlap or not.
+ * @param The Allocator.
  */
-bool pool_overlap(size_t increase) {
-
-    if (!current_alloc) { return false; }
+void drain_remote_frees(Allocator* alloc) {
 
-    LinkedList* list = current_alloc->list;
+    void* ptr = atomic_exchange_explicit(&alloc->remote_frees, NULL, memory_order_acquire);
 
-    if (list->size == 0) {
+    if (ptr == NULL) { return; }
 
-        /*
-         * The list is empty, thus there can be no overlap.
-         */
+    if (alloc->use_block_headers) {
 
-        return false;
+        // The owner caches the memory blocks like any of its own
+        while (ptr) {
 
-    }
+            void* next_ptr = *(void**) ptr;
+            headed_free(alloc, ptr);
+            ptr = next_ptr;
 
-    // Retrieve the memory pool borders
-    char* user_border = retrieve_user_pool_border();
-    char* reserved_border = current_alloc->reserved_pool_border;
+        }
 
-    /*
-     * Check if the pools overlap if we increase one of the pools.
-     * Note that the choice of pool to increase is arbitrary as
-     * they are the dual of each other.
-     */
-    if (user_border + increase > reserved_border) {
+        return;
 
-        /*
-         * The pool borders have reached each other.
-         * Attempt to reduce memory fragmentation in each pool.
-         */
-        cleanse_user_pool();
-        cleanse_reserved_pool();
+    }
 
-        // Retrieve the cleansed memory pool borders
-        user_border = retrieve_user_pool_border();
-        reserved_border = current_alloc->reserved_pool_border;
+    acquire_lock(&alloc->lock);
 
-        // Check if pool cleansing prevents pool overlap
-        if (user_border + increase > reserved_border) {
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
 
-            // Cleaning up the pools did not work, heap is considered full
-            return true;
+    while (ptr) {
 
-        }
+        void* next_ptr = *(void**) ptr;
+        unlocked_free(ptr);
+        ptr = next_ptr;
 
     }
 
-    return false;
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
 
 }
 
-void increase_reserved_pool(size_t increase) {
+void claim_allocator(Allocator* alloc) {
 
-    // Make sure it is aligned to a factor of 8
-    increase = align_size(increase);
+    if (alloc == NULL) { return; }
 
-    if (current_alloc == NULL) {
+    atomic_store_explicit(&alloc->owner_thread, pthread_self(), memory_order_release);
+    drain_remote_frees(alloc);
 
-        // There is no Allocator to operate on
-        return;
+}
 
-    }
+void maintenance_step(Allocator* alloc) {
 
-    if (pool_overlap(increase) == true) {
+    // The Allocator is in use, try again during the next step
+    if (!try_acquire_lock(&alloc->lock)) { return; }
 
-        // There is an overlap, the heap is considered full
-        return;
+    // Hand the surplus of the central bins back, where it merges with its free neighbours
+    for (size_t i = 0; alloc->use_central_bins && i < TCACHE_CLASS_COUNT; i++) {
 
-    }
+        CentralBin* bin = &alloc->central_bins[i];
+        void* surplus = NULL;
 
-    // Shift the border of the reserved pool downwards
-    current_alloc->reserved_pool_border -= increase;
-    current_alloc->reserved_pool_size += increase;
+        if (!try_acquire_lock(&bin->lock)) { continue; }
 
-    /*
-     * Need to also take away from the last free Node
-     * because that is where we take memory from when
-     * increasing the reserved pool border.
-     */
+        for (size_t j = 0; j < MAINTENANCE_BUDGET && bin->count > CENTRAL_BIN_REFILL; j++) {
 
-    LinkedList* list = current_alloc->list;
+            void* ptr = bin->stack;
+            bin->stack = *(void**) ptr;
+            bin->count--;
 
-    // TODO fix this so I dont have to sort
-    merge_sort_list(list);
+            *(void**) ptr = surplus;
+            surplus = ptr;
 
-    Node* tail = list->tail;
-    if (!tail) {
+        }
 
-        // There is no tail
-        return;
+        pthread_mutex_unlock(&bin->lock);
+
+        // The lock of the Allocator is recursive and already held, thus this never waits
+        if (surplus) { engine_free_chain(alloc, surplus); }
 
     }
 
-    MemoryData* tail_data = (MemoryData*) tail->data;
-    tail_data->block_size -= increase;
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
 
-}
+    // Release what was freed since the last release once it has decayed
+    if (alloc->freed_since_trim) { trim_after_free(0); }
 
-Node* create_metadata_node(char* memory_start, size_t block_size, bool is_free) {
+    if (alloc->engine == LIST_ENGINE) { compact_reserved_pool(MAINTENANCE_BUDGET); }
 
-    // Realign to a factor of 8 for memory efficency
-    block_size = align_size(block_size);
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
 
-    if (current_alloc == NULL || memory_start == NULL) {
+}
 
-        // There is no Allocator to work on or function argument missing!
-        return NULL;
+/*
+ * @brief Add an extent after the last one, large enough for an
+ * allocation of 'required_size' bytes, and allocate from it. The
+ * lock of the Allocator has to be held.
+ *
+ * @param1 The Allocator.
+ * @param2 The last Allocator of the chain of extents.
+ * @param3 The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if no extent could
+ * be created to hold it.
+ */
+void* add_extent(Allocator* alloc, Allocator* last, size_t required_size) {
 
-    }
+    // Grow geometrically, leaving room for the metadata of the extent
+    if (last->heap_size > SIZE_MAX / 2) { return NULL; }
 
-    // Increase the reserved pool to accommodate for the MemoryData
-    increase_reserved_pool(align_size(sizeof(MemoryData)));
+    size_t extent_size = 2 * last->heap_size;
 
-    MemoryData* data = (MemoryData*) current_alloc->reserved_pool_border;
+    while (extent_size / 4 < required_size) {
 
-    // Set MemoryData member variables
-    data->memory_start = memory_start;
-    data->block_size = block_size;
-    data->is_free = is_free;
-    data->in_use = true;
+        if (extent_size > SIZE_MAX / 2) { return NULL; }
 
-    // Increase the reserved pool to accommodate for the Node
-    increase_reserved_pool(align_size(sizeof(Node)));
+        extent_size *= 2;
 
-    // Create Node containing the MemoryData
-    Node* node = (Node*) current_alloc->reserved_pool_border;
+    }
 
-    // Set Node member variables
-    node->data_size = align_size(sizeof(MemoryData));
-    node->next = NULL;
-    node->id = 0;
-    node->data = (void*) data;
+    Allocator* extent = create_allocator_with_config(extent_size, alloc->extent_config);
 
-    return node;
+    if (extent == NULL) { return NULL; }
 
-}
+    void* ptr = allocator_malloc_from(extent, required_size);
 
-Node* merge_meta_data_nodes(LinkedList* list, Node* left_node, Node* right_node) {
+    if (ptr == NULL) {
 
-    if (list == NULL || left_node == NULL || right_node == NULL) {
+        // The engine cannot serve the size at all, do not keep an extent for it
+        Allocator* stored_alloc = current_alloc;
+        current_alloc = extent;
+        destroy_allocator();
+        current_alloc = stored_alloc;
 
-        // Function argument(s) missing
         return NULL;
 
     }
 
-    MemoryData* left_data = left_node->data;
-    MemoryData* right_data = right_node->data;
-
-    // Check that the 'left_node' is left adjacent to 'right_node'
-    if (left_data->memory_start + left_data->block_size != right_data->memory_start) {
+    atomic_store_explicit(&last->next_extent, extent, memory_order_release);
 
-        return NULL;
+    return ptr;
 
-    }
+}
 
-    // merge the block sizes
-    left_data->block_size += right_data->block_size;
+/*
+ * @brief Allocate memory from the extents of an Allocator whose
+ * managed heap is full, adding an extent when all of them are full.
+ *
+ * @param1 The Allocator.
+ * @param2 The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if no extent could hold it.
+ */
+void* extent_malloc(Allocator* alloc, size_t required_size) {
 
-    // Mark the right Node as vacant
-    right_data->in_use = false;
-    right_data->is_free = true;
+    Allocator* last = alloc;
+    Allocator* extent = atomic_load_explicit(&alloc->next_extent, memory_order_acquire);
 
-    /*
-     * Remove the discarded Node from the LinkedList.
-     * Note that when using drop_node(), the Node is
-     * not freed, only dropped from the list.
-     */
-    size_t id = right_node->id;
-    drop_node(list, id);
+    while (extent) {
 
-    return left_node;
+        void* ptr = allocator_malloc_from(extent, required_size);
 
-}
+        if (ptr) { return ptr; }
 
-void cleanse_user_pool() {
+        last = extent;
+        extent = atomic_load_explicit(&extent->next_extent, memory_order_acquire);
 
-    if (current_alloc == NULL) {
+    }
 
-        // There is no Allocator to operate on
-        return;
+    acquire_lock(&alloc->lock);
 
-    }
+    if (atomic_load_explicit(&last->next_extent, memory_order_acquire)) {
 
-    LinkedList* list = current_alloc->list;
+        // Another thread added an extent in the meantime, try it first
+        pthread_mutex_unlock(&alloc->lock);
+        return extent_malloc(alloc, required_size);
 
-    merge_sort_list(list);
+    }
 
-    /*
-     * Go through the list and for each Node that
-     * has a free memory block, see if it is able to merge
-     * with the Node that comes after in the LinkedList.
-    */
-    LinkedListIterator iter;
-    iter.current = get_head(list);
+    void* ptr = add_extent(alloc, last, required_size);
 
-    while (has_next(&iter)) {
+    pthread_mutex_unlock(&alloc->lock);
 
-        Node* node = next(&iter);
-        MemoryData* data = node->data;
+    return ptr;
 
-        if (data->is_free == false) {
+}
 
-            // Only Nodes with free memory blocks can be merged
-            continue;
+Allocator* extent_of(Allocator* alloc, void* ptr) {
 
-        }
+    char* location = (char*) ptr;
 
-        Node* next_node = node->next;
+    for (Allocator* extent = alloc; extent; ) {
 
-        if (!next_node) {
+        if (location >= extent->heap_start && location < extent->heap_end) {
 
-            // Have reached the end of the list
-            continue;
+            return extent;
 
         }
 
-        MemoryData* next_data = (MemoryData*) next_node->data;
-
-        if (next_data->is_free == false) {
+        extent = atomic_load_explicit(&extent->next_extent, memory_order_acquire);
 
-            /*
-             * The next Node does not have a free memory block,
-             * nothing to merge with and we can also skip
-             * the next Node.
-             */
-            next(&iter);
-            continue;
+    }
 
-        }
+    return NULL;
 
-        // We have a Node to merge with
-        merge_meta_data_nodes(list, node, next_node);
+}
 
-        /*
-         * With the Nodes merged, we have to check if the
-         * next Node of the merged Node is free and can
-         * be merged with.
-         */
+/*
+ * @brief Record a huge memory block in the side table of an
+ * Allocator, doubling the side table when it is full. The lock of
+ * the side table has to be held.
+ *
+ * @param1 The Allocator.
+ * @param2 The start of the mapping of the huge memory block.
+ * @param3 The length of the mapping.
+ * @return Whether the huge memory block was recorded.
+ */
+bool huge_block_insert(Allocator* alloc, void* ptr, size_t length) {
 
-        next_node = node->next;
-        next_data = (MemoryData*) next_node->data;
+    PointerIndex* table = &alloc->huge_blocks;
 
-        while (next_node && next_data->is_free) {
+    if (pointer_index_insert(table, ptr, (void*) length)) { return true; }
 
-            // The next Node is free as well, we can merge
-            merge_meta_data_nodes(list, node, next_node);
+    // The side table lives in a mapping of its own, starting out with a page
+    size_t capacity = table->capacity
+        ? 2 * table->capacity
+        : system_page_size() / sizeof(PointerIndexEntry);
+    size_t entries_size = capacity * sizeof(PointerIndexEntry);
 
-            next_node = node->next;
-            next_data = (MemoryData*) next_node->data;
+    PointerIndexEntry* entries = mmap(NULL, entries_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 
-        }
+    if (entries == MAP_FAILED) { return false; }
 
-    } // End while
+    PointerIndex grown;
+    pointer_index_init_zeroed(&grown, entries, capacity);
 
-}
+    for (size_t i = 0; i < table->capacity; i++) {
 
-/*
- * @details
- * Loop through the metadata Nodes in the reserved pool
- * from high memory to lower memory. If a metadata Node that is
- * not in use is found, then move the metadata Node at the pool
- * border to take its place and update the border pointer and
- * reserved pool size.
- *
- * A metadata Node consits of a Node and a MemoryData object.
- * Therefore, when going from high memory to lower memory, we
- * have the order:
- *
- * HIGH MEMORY
- *
- * MemoryData
- *
- * Node
- *
- * LOW MEMORY.
- */
-void cleanse_reserved_pool() {
+        if (table->entries[i].key) {
 
-    if (current_alloc == NULL) {
+            pointer_index_insert(&grown, table->entries[i].key, table->entries[i].value);
 
-        // There is no Allocator to operate on
-        return;
+        }
 
     }
 
-    /*
-     * TODO fix this so that we dont need to merge.
-     * We need it now because we have to make sure that
-     * the list is sorted to add memory back to the tail
-     * when moving the reserved pool border to higher memory.
-     */
-    LinkedList* list = current_alloc->list;
-    merge_sort_list(list);
-    Node* tail = list->tail;
-
-    // This will be the increments when doing metadata Node traversal
-    size_t meta_data_node_size = align_size(sizeof(Node)) + align_size(sizeof(MemoryData));
+    if (table->entries) { munmap(table->entries, table->capacity * sizeof(PointerIndexEntry)); }
 
-    /*
-     * Memory location for the start of metadata Node traversal.
-     * Note that during Allocator creation, a metadata Node is
-     * created to accommodate for the memory block of the whole
-     * user pool. Thus, the first metadata Node is located at the
-     * initial reserved pool border during creation.
-     */
-    char* meta_data_node =
-        current_alloc->heap_end
-        - current_alloc->initial_reserved_pool_size;
+    *table = grown;
 
-    // Iterate through the metadata Nodes
-    while (meta_data_node >= current_alloc->reserved_pool_border) {
+    return pointer_index_insert(table, ptr, (void*) length);
 
-        // Retrieve Node's corresponding MemoryData
-        MemoryData* data = (MemoryData*) (meta_data_node + align_size(sizeof(Node)));
+}
 
-        /*
-         * Check if we have found a Node that is not
-         * in use by the LinkedList.
-         */
-        if (data->in_use == false) {
+/*
+ * @brief Allocate a huge memory block in a mapping of its own.
+ *
+ * @param1 The Allocator.
+ * @param2 The required size of the memory block.
+ * @return A pointer to the memory block, or NULL if it could not be mapped.
+ */
+void* huge_malloc(Allocator* alloc, size_t required_size) {
 
-            /*
-             * Search for a border Node that is in use by the
-             * LinkedList. If it is not in use, then we can
-             * ignore it and move the border to the next
-             * metadata Node that is in use.
-             */
+    size_t page_size = system_page_size();
 
-            Node* border_node = (Node*) current_alloc->reserved_pool_border;
-            MemoryData* border_data = (MemoryData*) border_node->data;
+    if (required_size > SIZE_MAX - page_size) { return NULL; }
 
-            while (!border_data->in_use) {
+    size_t length = (required_size + page_size - 1) / page_size * page_size;
 
-                // Shift the reserved pool border by one metadata Node
-                current_alloc->reserved_pool_border += meta_data_node_size;
-                current_alloc->reserved_pool_size -= meta_data_node_size;
+    void* ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 
-                // Update for next iteration
-                border_node = (Node*) current_alloc->reserved_pool_border;
-                border_data = (MemoryData*) border_node->data;
+    if (ptr == MAP_FAILED) { return NULL; }
 
-            }
+    pthread_mutex_lock(&alloc->huge_lock);
+    bool recorded = huge_block_insert(alloc, ptr, length);
+    pthread_mutex_unlock(&alloc->huge_lock);
 
-            if ((char*) border_node == meta_data_node) {
+    if (!recorded) {
 
-                // No unique Node was found
-                return;
+        munmap(ptr, length);
+        return NULL;
 
-            }
+    }
 
-            // Move the border metadata Node to the vacant space
-            memcpy(meta_data_node, border_node, meta_data_node_size);
+    return ptr;
 
-            // Shift the border now that the border Node has been moved
-            current_alloc->reserved_pool_border += meta_data_node_size;
-            current_alloc->reserved_pool_size -= meta_data_node_size;
+}
 
-            // Increase the memory in the tail Node as it gets
-            // the freed reserved memory. TODO FIX THIS WITH THE MERGE AT BEGINNING
-            MemoryData* tail_data = (MemoryData*) tail->data;
-            tail_data->block_size += meta_data_node_size;
+size_t huge_block_size(Allocator* alloc, void* ptr) {
 
-        }
+    if (alloc->huge_threshold == 0) { return 0; }
 
-        // Update traversal data
-        meta_data_node -= meta_data_node_size;
+    pthread_mutex_lock(&alloc->huge_lock);
+    size_t length = (size_t) pointer_index_lookup(&alloc->huge_blocks, ptr);
+    pthread_mutex_unlock(&alloc->huge_lock);
 
-    }
+    return length;
 
 }
 
 /*
- * @brief Create a residual Node from the original input Node.
- * and update the original Node by discarding the memory block
- * now given to the residual Node.
+ * @brief Unmap a huge memory block. Only pointers outside the managed
+ * heaps of the Allocator and its extents are looked up.
  *
- * @param1 The Node to use to create the residual Node.
- * @param2 The desired memory block size of the residual Node.
- * @return A pointer to the residual Node.
+ * @param1 The Allocator.
+ * @param2 The pointer to the memory block.
+ * @return Whether 'ptr' was a huge memory block.
  */
-Node* create_residual_node(Node* node, size_t residual_size) {
-
-    // Realign to a factor of 8 for memory efficency
-    residual_size = align_size(residual_size);
-
-    if (!node || residual_size == 0) { return NULL; }
-
-    MemoryData* data = (MemoryData*) node->data;
+bool huge_free(Allocator* alloc, void* ptr) {
 
-    if (data->block_size <= residual_size) {
+    if (alloc->huge_threshold == 0) { return false; }
 
-        /*
-         * The size of the memory block of the residual Node has
-         * to be smaller than the block size of the original Node.
-         */
-        return NULL;
+    pthread_mutex_lock(&alloc->huge_lock);
 
-    }
+    size_t length = (size_t) pointer_index_lookup(&alloc->huge_blocks, ptr);
 
-    // Need to split up such that the residual memory is in a free Node
-    char* residual_memory_start =
-        data->memory_start
-        + data->block_size
-        - residual_size;
-    bool residual_is_free = true;
+    if (length) { pointer_index_remove(&alloc->huge_blocks, ptr); }
 
-    Node* residual_node = create_metadata_node(
-        residual_memory_start,
-        residual_size,
-        residual_is_free
-    );
+    pthread_mutex_unlock(&alloc->huge_lock);
 
-    // Subtract the residual size from the original Node
+    if (length == 0) { return false; }
 
-    /*
-     * TODO this part of the code works, but it should be
-     * refactored. The problem is that during the
-     * create_metadata_node call, the reserved pool border
-     * is increased, taking memory from the tail Node
-     * as intended. However, this alters the block size
-     * of the tail Node. When we then in the code below
-     * want to simply subtract the residual size because
-     * that is what is being given to the residual Node,
-     * we now have the issue that the orignal Node
-     * no longer is the tail node, but the residual Node
-     * is. Thus, we need to add back the memory for
-     * creating the meta data node and instead subtract
-     * that from the residual node as that is the new tail
-     * which is next to the reserved pool border.
-     */
-    data->block_size += current_alloc->meta_data_node_size;
-    data->block_size -= residual_size;
-    MemoryData* residual_data = (MemoryData*) residual_node->data;
-    residual_data->block_size -= current_alloc->meta_data_node_size;
+    munmap(ptr, length);
 
-    return residual_node;
+    return true;
 
 }
 
-void* allocator_malloc(size_t required_size) {
+/*
+ * @brief Resize a huge memory block by remapping it. The kernel moves
+ * the page tables rather than the contents, should the mapping have
+ * to move.
+ *
+ * @param1 The Allocator.
+ * @param2 The pointer to the huge memory block.
+ * @param3 The length of its mapping.
+ * @param4 The desired size of the memory block, at least 'huge_threshold'.
+ * @return A pointer to the resized memory block, or NULL if it could
+ * not be remapped, leaving the memory block untouched.
+ */
+void* huge_realloc(Allocator* alloc, void* ptr, size_t length, size_t size) {
 
-    // Realign to a factor of 8 for memory efficency
-    required_size = align_size(required_size);
+    size_t page_size = system_page_size();
 
-    if (current_alloc == NULL) {
+    if (size > SIZE_MAX - page_size) { return NULL; }
 
-        // There is no Allocator to operate on
-        return NULL;
+    size_t new_length = (size + page_size - 1) / page_size * page_size;
+
+    if (new_length == length) { return ptr; }
 
-    }
+    void* new_ptr = mremap(ptr, length, new_length, MREMAP_MAYMOVE);
 
-    // Attempt to find a Node with an available memory block
-    Node* available_node = naive_search(required_size);
+    if (new_ptr == MAP_FAILED) { return NULL; }
 
-    if (available_node == NULL) {
+    // The side table keeps its size, thus the new entry always fits
+    pthread_mutex_lock(&alloc->huge_lock);
 
-        /*
-         * No available Node was found, start pool cleansing
-         * to potentially reduce memory fragmentation and get
-         * more space.
-         */
-        cleanse_user_pool();
-        cleanse_reserved_pool();
+    pointer_index_remove(&alloc->huge_blocks, ptr);
+    huge_block_insert(alloc, new_ptr, new_length);
 
-        // Try again to find an available memory block
-        available_node = naive_search(required_size);
+    pthread_mutex_unlock(&alloc->huge_lock);
 
-        if (available_node == NULL) {
+    return new_ptr;
 
-            // The managed heap is full
-            return NULL;
+}
 
-        }
+/*
+ * @brief Move a memory block to a new one taken from an Allocator,
+ * its extents or a mapping of its own, once reallocating it in place
+ * failed or is not wanted.
+ *
+ * @param1 The Allocator.
+ * @param2 The Allocator or extent holding the memory block.
+ * @param3 The pointer to the memory block.
+ * @param4 The desired size of the memory block.
+ * @return A pointer to the moved memory block, or NULL if there is
+ * no memory block in use at 'ptr' or no room for the new one.
+ */
+void* move_block(Allocator* alloc, Allocator* owner, void* ptr, size_t size) {
 
-    }
+    size_t old_size = allocator_usable_size_in(owner, ptr);
 
-    /*
-     * A Node has been found. Inspect Node to see how to split
-     * up into allocated memory Node and residual memory Node.
-     */
+    if (old_size == 0) { return NULL; }
 
-    // Retrieve Node data
-    MemoryData* available_data = (MemoryData*) available_node->data;
-    size_t node_block_size = available_data->block_size;
+    void* new_location = allocator_malloc_from(alloc, size);
 
-    if (node_block_size == required_size) {
+    if (!new_location) { return NULL; }
 
-        /*
-         * Node carries exact required memory block size.
-         * Can then just use the Node as is.
-         */
-        available_data->is_free = false;
+    memcpy(new_location, ptr, old_size < size ? old_size : size);
+    allocator_free_to(owner, ptr);
 
-    } else {
+    return new_location;
 
-        // See if there is enough space to create a metadata Node
-        if (pool_overlap(current_alloc->meta_data_node_size)) {
+}
 
-            /*
-             * There is not enough space to create more metadata Nodes.
-             * However, since the Nodes fits the size we want to
-             * allocate, we just use the Node as is.
-             */
+void* allocator_malloc_from(Allocator* alloc, size_t required_size) {
 
-            available_data->is_free = false;
-            return available_data->memory_start;
+    if (alloc == NULL) {
 
-        }
+        // There is no Allocator to operate on
+        return NULL;
 
-        // Construct the residual metadata Node
-        size_t residual_memory_size = node_block_size - required_size;
-        Node* residual_node = create_residual_node(available_node, residual_memory_size);
+    }
 
-        add(current_alloc->list, residual_node);
+    if (alloc->use_remote_frees && pthread_equal(atomic_load_explicit(&alloc->owner_thread, memory_order_acquire), pthread_self())
+        && atomic_load_explicit(&alloc->remote_frees, memory_order_relaxed)) {
 
-        // Modify 'available_node' to reflect that it is now in use
-        available_data->is_free = false;
+        drain_remote_frees(alloc);
 
     }
 
-    // Return the pointer to the start of the allocated memory
-    return available_data->memory_start;
+    void* ptr = NULL;
 
-}
+    if (alloc->huge_threshold && required_size >= alloc->huge_threshold) {
 
-Node* naive_search(size_t size) {
+        // Huge memory blocks stay out of the managed heap
+        return huge_malloc(alloc, required_size);
 
-    // Realign to a factor of 8 for memory efficency
-    size = align_size(size);
+    } else if (alloc->use_block_headers) {
 
-    // Loop through the LinkedList and find the first vacant memory block
-    LinkedListIterator iter;
-    iter.current = current_alloc->list->head;
-    Node* found_node = NULL;
-    while (has_next(&iter)) {
+        ptr = headed_malloc(alloc, required_size);
 
-        Node* node = next(&iter);
-        MemoryData* data = (MemoryData*) node->data;
+    } else {
 
-        if (data->is_free && size <= data->block_size) {
+        acquire_lock(&alloc->lock);
 
-            // A Node has been found
-            found_node = node;
-            break;
+        // The internal functions operate on 'current_alloc'
+        Allocator* stored_alloc = current_alloc;
+        current_alloc = alloc;
 
-        }
+        ptr = unlocked_malloc(required_size);
+
+        current_alloc = stored_alloc;
+        pthread_mutex_unlock(&alloc->lock);
 
     }
 
-    return found_node;
+    if (ptr == NULL && alloc->use_extents && required_size > 0) {
+
+        // The managed heap is full, continue in the extents
+        ptr = extent_malloc(alloc, required_size);
+
+    }
+
+    return ptr;
 
 }
 
-/*
- * @details
- * When merging to the left adjacent Node, we only have to check if the
- * start of the memory block is equal to the 'memory_start' + 'block_size'
- * of the left adjacent Node (and that the left adjacent Node is free
- * of course).
- *
- * Analogously for the right adjacent Node, we compare the
- * 'memory_start' + 'block_size' to the 'memory_start' of the right
- * adjacent Node.
- *
- * The Node that is to be set free should (if no bug has occured) at most
- * merge with two Nodes, both being adjacent. Assuming this is not the case,
- * say it merges with the right adjacent Node, and then this newly merged
- * Node again merges with its right adjacent Node, then the two Nodes
- * that was merged with the free Node should have been merged beforehand.
- * Therefore, we can assume that is the case, thus we only have to do
- * at most two merges.
- */
-void allocator_free(void* ptr) {
+void allocator_free_to(Allocator* alloc, void* ptr) {
 
-    if (current_alloc == NULL) {
+    if (alloc == NULL) {
 
         // There is no Allocator object to process
         return;
 
     }
 
-    LinkedList* list = current_alloc->list;
-
-    // Create iterator on the stack
-    LinkedListIterator iter;
-    iter.current = get_head(list);
+    Allocator* owner = extent_of(alloc, ptr);
 
-    if (get_head(list) == NULL) {
+    if (owner != alloc) {
 
-        // There is no head Node, a bug has occured
+        // Memory of an extent is freed by the extent, any other memory can only be a huge memory block
+        if (owner) { allocator_free_to(owner, ptr); } else { huge_free(alloc, ptr); }
         return;
 
     }
 
-    // Search for the Node corresponding to 'ptr' in the LinkedList
-    Node* matched_node = NULL;
-    while (has_next(&iter)) {
+    if (alloc->use_remote_frees && !pthread_equal(atomic_load_explicit(&alloc->owner_thread, memory_order_acquire), pthread_self())) {
 
-        Node* node = next(&iter);
-        MemoryData* data = (MemoryData*) node->data;
+        // Leave the memory block to the owner rather than contending for the lock
+        push_remote_free(alloc, ptr);
+        return;
 
-        if (data->memory_start == ptr && !data->is_free) {
+    }
 
-            // Node has been found
-            matched_node = node;
-            break;
+    if (alloc->use_block_headers) { headed_free(alloc, ptr); return; }
 
-        }
+    acquire_lock(&alloc->lock);
 
-        node = node->next;
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
 
-    }
+    unlocked_free(ptr);
 
-    if (!matched_node) {
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
 
-       /*
-        * The corresponding Node was not found.
-        * the Allocator has not given out this pointer.
-        */
-        return;
+}
 
-    }
+void* allocator_realloc_in(Allocator* alloc, void* ptr, size_t size) {
 
-    MemoryData* matched_data = (MemoryData*) matched_node->data;
-    char* matched_memory_start = matched_data->memory_start;
-    char* matched_memory_end = matched_memory_start + matched_data->block_size;
+    if (!alloc || !ptr) { return NULL; }
 
-    // Mark the memory block as free
-    matched_data->is_free = true;
+    Allocator* owner = extent_of(alloc, ptr);
 
-    /*
-     * Reset the iterator and see if the newly freed Node
-     * has adjacent free Nodes that it can merge with.
-     */
-    iter.current = get_head(list);
+    if (owner == NULL) {
 
-    while (has_next(&iter)) {
+        // Memory outside the managed heaps can only be a huge memory block
+        size_t huge_size = huge_block_size(alloc, ptr);
 
-        Node* node = next(&iter);
+        if (huge_size == 0) { return NULL; }
 
-        // This is the same Node
-        if (node->id == matched_node->id) { continue; }
+        if (size == 0) { huge_free(alloc, ptr); return NULL; }
 
-        MemoryData* data = node->data;
-        char* memory_start = data->memory_start;
-        char* memory_end = memory_start + data->block_size;
+        // A huge memory block staying huge is remapped instead of copied
+        if (size >= alloc->huge_threshold) { return huge_realloc(alloc, ptr, huge_size, size); }
 
-        // Check if there is a right adjacent Node to merge with
-        if (memory_start == matched_memory_end && data->is_free) {
+        return move_block(alloc, alloc, ptr, size);
 
-            merge_meta_data_nodes(list, matched_node, node);
+    }
 
-            // Update the block size ends
-            matched_memory_start = matched_data->memory_start;
-            matched_memory_end = matched_memory_start + matched_data->block_size;
+    if (alloc->huge_threshold && size >= alloc->huge_threshold) {
 
-        }
+        // Growing into a huge memory block moves it into a mapping of its own
+        return move_block(alloc, owner, ptr, size);
 
-        // Check if there is a left adjacent Node to merge with
-        if (memory_end == matched_memory_start && data->is_free) {
+    }
 
-            merge_meta_data_nodes(list, node, matched_node);
-            /*
-             * Since merging results in the left Node remaining,
-             * 'matched_node' will be discarded from the list.
-             * Therefore, update to keep track of the matched
-             * Node.
-             */
-            matched_node = node;
+    void* new_location = NULL;
 
-            // Update the block size ends
-            matched_memory_start = matched_data->memory_start;
-            matched_memory_end = matched_memory_start + matched_data->block_size;
+    if (owner != alloc) {
 
-        }
+        new_location = allocator_realloc_in(owner, ptr, size);
 
-    }
+    } else if (alloc->use_block_headers) {
 
-}
+        new_location = headed_realloc(alloc, ptr, size);
 
-void* allocator_realloc(void* ptr, size_t size) {
+    } else {
 
-    // Realign to a factor of 8 for memory efficency
-    size = align_size(size);
+        acquire_lock(&alloc->lock);
 
-    if (!current_alloc || !ptr) { return NULL; }
+        Allocator* stored_alloc = current_alloc;
+        current_alloc = alloc;
 
-    /*
-     * Reallocating to a memory block of size 0
-     * is the same as freeing the memory block.
-     */
-    if (size == 0) { free(ptr); return NULL; }
+        new_location = unlocked_realloc(ptr, size);
 
-    LinkedList* list = current_alloc->list;
-    merge_sort_list(list);
+        current_alloc = stored_alloc;
+        pthread_mutex_unlock(&alloc->lock);
 
-    LinkedListIterator iter;
-    iter.current = list->head;
+    }
 
-    /*
-     * Retrieve the left adjacent Node for potensially merging
-     * later in the function.
-     */
-    Node* prev_node = NULL;
+    if (new_location == NULL && alloc->use_extents && size > 0) {
 
-    // Search for Node corresponding to argument pointer
-    Node* ptr_node = NULL;
-    while (has_next(&iter)) {
+        // There is no room left next to the memory block, move it to any extent
+        new_location = move_block(alloc, owner, ptr, size);
 
-        Node* node = next(&iter);
-        MemoryData* data = node->data;
+    }
 
-        if (ptr == (void*) data->memory_start) {
+    return new_location;
 
-            // corresponding Node has been found
-            ptr_node = node;
-            break;
+}
 
-        }
+size_t allocator_usable_size_in(Allocator* alloc, void* ptr) {
 
-        prev_node = node;
+    if (!alloc || !ptr) { return 0; }
 
-    } // End while
+    Allocator* owner = extent_of(alloc, ptr);
 
-    // Check for corresponding pointer
-    if (!ptr_node) { return NULL; }
+    if (owner != alloc) {
 
-    MemoryData* ptr_data = (MemoryData*) ptr_node->data;
+        // Memory outside the managed heaps can only be a huge memory block
+        return owner ? allocator_usable_size_in(owner, ptr) : huge_block_size(alloc, ptr);
 
-    // Check that it not already freed
-    if (ptr_data->is_free) { return NULL; }
+    }
 
-    if (size == ptr_data->block_size) {
+    void* block = ptr;
+    size_t header_size = 0;
 
-        /*
-         * The function call has requested a realloc
-         * where the memory block size remains the same.
-         */
-        return ptr;
+    if (alloc->use_block_headers) {
 
-    } else if (size < ptr_data->block_size) {
+        TcacheHeader* header = block_header(alloc, ptr);
 
-        /*
-         * The function call has requested a trimming
-         * of the memory block.
-         */
+        if (header == NULL) { return 0; }
 
-        ptr_data->block_size = size;
+        // Small memory blocks are rounded up to their size class
+        if (header->size_class < TCACHE_CLASS_COUNT) { return tcache_class_size(header->size_class); }
 
-        // Create Node for the freed memory
-        char* freed_memory_start = ptr_data->memory_start + size;
-        size_t freed_block_size = ptr_data->block_size - size;
-        bool freed_is_free = true;
+        block = header;
+        header_size = TCACHE_HEADER_SIZE;
 
-        Node* freed_node = create_metadata_node(
-            freed_memory_start,
-            freed_block_size,
-            freed_is_free
-        );
+    }
 
-        add(list, freed_node);
+    acquire_lock(&alloc->lock);
 
-        return ptr;
+    Allocator* stored_alloc = current_alloc;
+    current_alloc = alloc;
 
-    }
+    size_t size = unlocked_usable_size(block);
 
-    /*
-     * The function call has requested an extension of the
-     * associated memory block.
-     */
+    current_alloc = stored_alloc;
+    pthread_mutex_unlock(&alloc->lock);
 
-    // Check if the adjacent Nodes are free
-    bool left_node_free = false;
-    bool right_node_free = false;
-    size_t left_node_size = 0;
-    size_t right_node_size = 0;
+    return size > header_size ? size - header_size : 0;
 
-    // Check if we can merge with the left adjacent Node
-    if (prev_node) {
+}
 
-        MemoryData* prev_data = (MemoryData*) prev_node->data;
+void* allocator_malloc(size_t required_size) {
 
-        if (prev_data->is_free) {
+    return allocator_malloc_from(current_alloc, required_size);
 
-            left_node_free = true;
-            left_node_size = prev_data->block_size;
+}
 
-        }
+void allocator_free(void* ptr) {
 
-    }
+    allocator_free_to(current_alloc, ptr);
 
-    // Check if we can merge with the right adjacent Node
-    Node* next_node = ptr_node->next;
-    if (next_node) {
+}
 
-        MemoryData* next_data = (MemoryData*) next_node->data;
+void* allocator_realloc(void* ptr, size_t size) {
 
-        if (next_data->is_free) {
+    return allocator_realloc_in(current_alloc, ptr, size);
 
-            right_node_free = true;
-            right_node_size = next_data->block_size;
+}
 
-        }
+size_t allocator_usable_size(void* ptr) {
 
-    }
+    return allocator_usable_size_in(current_alloc, ptr);
 
-    /*
-     * Evaluate the adjacent Nodes and determine if
-     * the merging of the memory blocks is sufficient
-     * for the size as requested in the function argument.
-     */
-    if (
-        right_node_free &&
-        ptr_data->block_size + right_node_size >= size
-    ) {
+}
 
-        // Merging with the right Node is sufficient
-        Node* merged_node = merge_meta_data_nodes(list, ptr_node, next_node);
-        MemoryData* merged_data = (MemoryData*) merged_node->data;
+void destroy_allocator() {
 
-        // Need to split up such that the residual memory is in a free node
-        size_t residual_block_size = merged_data->block_size - size;
-        Node* residual_node = create_residual_node(merged_node, residual_block_size);
+    if (current_alloc == NULL) {
 
-        add(list, residual_node);
+        // There is no Allocator object to process
+        return;
 
-        return merged_data->memory_start;
+    }
 
-    } else if (
-        left_node_free &&
-        ptr_data->block_size + left_node_size >= size
-    ) {
+    stop_maintenance_thread(current_alloc);
 
-        // Merging with the left Node is sufficient
-        Node* merged_node = merge_meta_data_nodes(list, prev_node, ptr_node);
-        MemoryData* merged_data = (MemoryData*) merged_node->data;
+    // Unmap the huge memory blocks along with their side table
+    PointerIndex* huge_blocks = &current_alloc->huge_blocks;
 
-        /*
-         * Since merging keeps the left Node, which was free in this case,
-         * we need to set the newly merged Node to non-free.
-         */
-        merged_data->is_free = false;
+    for (size_t i = 0; i < huge_blocks->capacity; i++) {
 
-        // Need to split up such that the residual memory is in a free node
-        size_t residual_block_size = merged_data->block_size - size;
-        Node* residual_node = create_residual_node(merged_node, residual_block_size);
+        if (huge_blocks->entries[i].key) {
 
-        add(list, residual_node);
+            munmap(huge_blocks->entries[i].key, (size_t) huge_blocks->entries[i].value);
 
-        return merged_data->memory_start;
+        }
 
-    } else if (
-        left_node_free &&
-        right_node_free &&
-        ptr_data->block_size + left_node_size + right_node_size >= size
-    ) {
+    }
 
-        // Merging with both the Nodes is sufficient
-        Node* merged_node = merge_meta_data_nodes(list, ptr_node, next_node);
-        merged_node = merge_meta_data_nodes(list, prev_node, merged_node);
+    if (huge_blocks->entries) {
 
-        MemoryData* merged_data = (MemoryData*) merged_node->data;
-        /*
-         * Since merging keeps the left Node, which was free in this case,
-         * we need to set the newly merged Node to non-free.
-         */
-        merged_data->is_free = false;
+        munmap(huge_blocks->entries, huge_blocks->capacity * sizeof(PointerIndexEntry));
 
-        // Need to split up such that the residual memory is in a free node
-        size_t residual_block_size = merged_data->block_size - size;
-        Node* residual_node = create_residual_node(merged_node, residual_block_size);
+    }
 
-        add(list, residual_node);
+    // The extents go first, each is an Allocator of its own linked to the next
+    Allocator* extent = atomic_load_explicit(&current_alloc->next_extent, memory_order_acquire);
 
-        return merged_data->memory_start;
+    while (current_alloc->use_extents && extent) {
 
-    } else {
+        Allocator* next_extent = atomic_load_explicit(&extent->next_extent, memory_order_acquire);
 
-        /*
-         * Merging with the adjacent Nodes are either
-         * not possible or not sufficient. Thus, we
-         * need to look for a new location on the
-         * managed heap.
-         */
+        Allocator* stored_alloc = current_alloc;
+        current_alloc = extent;
+        destroy_allocator();
+        current_alloc = stored_alloc;
 
-        void* new_location = allocator_malloc(size);
+        extent = next_extent;
 
-        /*
-        * Copy the memory data from the original and place it
-        * in the new location.
-        */
-        memcpy(new_location, ptr_data->memory_start, ptr_data->block_size);
+    }
 
-        // Free the original Node as it is no longer in use
-        allocator_free(ptr);
+    /*
+     * The memory blocks cached by threads vanish along with the
+     * managed heap, their ThreadCaches start over empty.
+     */
+    for (ThreadCache* cache = current_alloc->thread_caches; cache; cache = cache->next) {
 
-        return new_location;
+        tcache_init(&cache->bins);
+        cache->owner = NULL;
 
     }
 
-    return NULL;
+    destroy_allocator_locks(current_alloc);
 
-}
+    if (current_alloc->heap_source == HEAP_SHARED) {
 
-void destroy_allocator() {
+        // Remove the shared memory object once every process has unmapped it
+        shm_unlink(current_alloc->shared_name);
+        munmap(current_alloc->heap_start, current_alloc->heap_size);
+        return;
 
-    if (current_alloc == NULL) {
+    }
 
-        // There is no Allocator object to process
+    if (current_alloc->heap_source == HEAP_MMAP) {
+
+        // Hand the pages straight back to the kernel
+        munmap(current_alloc->heap_start, current_alloc->heap_size);
         return;
 
     }
@@ -30,6 +30,13 @@
  * the Node will share the required memory by splitting
  * up into one Node for the allocated memory and one
  * for the remaining free memory.
+ * The Node for the remaining free memory is inserted right
+ * after the split Node, keeping the LinkedList sorted by
+ * memory address at all times. Thus, the tail Node always
+ * holds the memory block at the top of the user pool.
+ * As every Node also references the previous Node, a Node is
+ * unlinked from the LinkedList in constant time when memory
+ * blocks are merged or its metadata is moved.
  *
  * The payload of each Node will be a pointer to the
  * start of the memory block and a size_t to
@@ -37,6 +44,49 @@
  * There will also be a boolean variable to tell
  * whether the memory block is free or in use.
  *
+ * Each memory block in the user pool is surrounded by boundary
+ * tags. The first and last bytes of a memory block hold a header
+ * tag and a footer tag, both referencing the metadata Node of
+ * the memory block. The pointer handed out to the user points
+ * right after the header tag. Therefore, the metadata Node of a
+ * pointer, along with the metadata Nodes of both physically
+ * adjacent memory blocks, are found through pointer arithmetic
+ * rather than by traversing the LinkedList.
+ *
+ * The Nodes of the memory blocks in use are also kept in a
+ * pointer index, an open addressing hash table stored in the
+ * reserved pool that maps the start of a memory block to its
+ * Node. It lets allocator_free() and allocator_realloc() verify
+ * a pointer without reading the memory around it. The pointer
+ * index is sized during creation. Should it fill up, the
+ * remaining memory blocks are found through their header tag.
+ *
+ * To avoid traversing the whole LinkedList on every allocation,
+ * the Nodes with free memory blocks are additionally kept in
+ * segregated free lists (bins), one for each power-of-two
+ * size class. An allocation only has to inspect the bin
+ * matching its size class and otherwise pops the first Node
+ * of a larger non-empty bin, found through a bitmap.
+ *
+ * Alternatively, the Allocator may be created with a best-fit
+ * placement policy. The free Nodes are then kept in a balanced
+ * tree ordered by memory block size instead, such that the
+ * tightest fitting memory block is found in logarithmic time.
+ *
+ * All of the above describes the list engine. An Allocator may
+ * instead be created with the TLSF engine, which hands the whole
+ * user pool over to a TlsfControl stored in the reserved pool.
+ * Memory blocks then carry inline headers, no metadata Nodes are
+ * created and both allocator_malloc() and allocator_free() run in
+ * constant time, as no cleansing of the pools is ever needed.
+ * The buddy engine does the same with a BuddyControl, handing out
+ * power-of-two sized memory blocks merged with their buddies.
+ *
+ * On top of any engine, small objects may be served from slabs.
+ * A slab is a memory block allocated from the engine and split
+ * into objects of a single size class, tracked by a bitmap. Small
+ * objects then cost a bit instead of a memory block of their own.
+ *
  * In order to now have to modify the function prototypes
  * for the LinkedList and Node by having to pass an
  * Allocator object to use the Allocator functions like
@@ -49,6 +99,98 @@
  * set() and release(), to assign Allocator objects to the
  * 'current_allocator' pointer variable.
  *
+ * The 'current_alloc' variable is thread-local, thus every
+ * thread sets the Allocator it uses on its own. An Allocator may
+ * be shared by several threads, as every Allocator function holds
+ * the lock of the Allocator while it operates on it. Threads using
+ * different Allocators never wait for each other.
+ *
+ * Code juggling several Allocators may pass the Allocator directly
+ * through allocator_malloc_from(), allocator_free_to() and
+ * allocator_realloc_in() instead of calling set_allocator() in
+ * between. They leave 'current_alloc' of the thread untouched.
+ *
+ * An Allocator created with 'use_thread_cache' prefixes every memory
+ * block with a small header. Small memory blocks freed by a thread
+ * are then cached in a ThreadCache of that thread and reused by its
+ * next allocations of the same size class, without taking the lock.
+ * A thread has THREAD_CACHE_SLOTS ThreadCaches, each caching the
+ * memory blocks of another Allocator, such that a thread alternating
+ * between a few Allocators keeps all of their caches. Once a size
+ * class exceeds TCACHE_HIGH_WATER memory blocks, a batch is handed
+ * back to the Allocator. A whole ThreadCache is handed back when the
+ * thread exits, or when every ThreadCache is taken and yet another
+ * Allocator is used, the ThreadCaches taking turns.
+ *
+ * With 'use_remote_frees', the thread creating an Allocator owns it.
+ * Memory blocks freed by other threads are pushed on a lock-free
+ * stack instead, and the owner frees them in a single batch during
+ * its next allocation. A pointer given to a queued free is only
+ * checked to lie within the user pool, it is verified once drained.
+ * Freeing the same pointer twice from other threads before the owner
+ * drains the stack is not detected.
+ *
+ * With 'use_central_bins', small memory blocks are prefixed with the
+ * same header and freed into a central bin of their size class
+ * rather than to the engine, either directly or when a ThreadCache
+ * hands them back. Every central bin has a lock of its own, thus
+ * threads allocating and freeing different size classes do not wait
+ * for each other. Only an empty central bin being refilled, or a full
+ * one handing memory blocks back, takes the lock of the Allocator,
+ * along with large memory blocks, cleansing and growing the
+ * reserved pool.
+ *
+ * With 'use_maintenance_thread', a thread of the Allocator wakes up
+ * every 'maintenance_interval_ms' and, only if the lock of the
+ * Allocator is free, compacts the reserved pool by at most
+ * MAINTENANCE_BUDGET metadata Nodes. It also hands surplus memory
+ * blocks of the central bins back to the engine. Thus, allocations
+ * rarely have to cleanse the pools themselves. Freed memory blocks
+ * are already merged with their free neighbours right away.
+ *
+ * With 'use_cpu_cache', small memory blocks are cached by the CPU
+ * freeing them rather than the thread, in a CpuCache stored in the
+ * reserved pool. The memory held by caches is then bounded by the
+ * number of CPUs, no matter how many threads use the Allocator. A
+ * CpuCache is found through the CPU the thread runs on and taken
+ * with a trylock. Should the thread have migrated and the CpuCache
+ * be busy, the memory block goes to the central bins or the engine.
+ *
+ * With 'use_extents', an Allocator whose managed heap is full adds an
+ * extent, an Allocator of its own twice as large as the one before,
+ * rather than failing. Allocations continue in the extents once the
+ * managed heap is full, and frees are routed to the extent holding
+ * the pointer. Reallocations move between extents as needed.
+ *
+ * Free memory blocks spanning whole pages may release these pages to
+ * the system with madvise(), lowering the resident memory after a
+ * spike. allocator_trim() does so right away. With 'trim_threshold'
+ * set, free memory blocks of at least that size are released once
+ * as many bytes have been freed, at most every 'trim_decay_ms', such
+ * that memory freed and reused in quick succession is left alone.
+ * Cleansing the user pool and the maintenance thread release them too.
+ *
+ * With 'huge_threshold' set, allocations of at least that size are
+ * mapped with mmap() on their own instead of being carved out of the
+ * managed heap, and unmapped right away once freed. A side table of
+ * the Allocator holds their mappings. Thus, large transient memory
+ * blocks never fragment the managed heap. Reallocating a huge memory
+ * block remaps it with mremap(), such that growing it moves page
+ * tables rather than copying its contents.
+ *
+ * With 'use_mmap', the managed heap is reserved with mmap() instead
+ * of malloc(), rounded up to whole pages and without swap backing it.
+ * Only the pages touched are committed, thus a very large managed
+ * heap costs memory only for what is in use.
+ *
+ * create_shared_allocator() places the managed heap in a POSIX shared
+ * memory object instead, mapped at the same address by every process
+ * calling attach_shared_allocator(). The metadata then stays valid
+ * in all of them without translating its pointers, and the locks are
+ * shared between processes and robust against a process dying while
+ * holding them. Pointers passed between processes through other means
+ * may still be converted with allocator_offset() and allocator_pointer().
+ *
  * TERMINOLOGY:
  *
  * managed heap / sub-heap: The memory managed my
@@ -71,10 +213,217 @@
 
 #include "../linked_list/linked_list.h"
 #include "../other_modules/memory_data.h"
+#include "../pointer_index/pointer_index.h"
+#include "../tlsf/tlsf.h"
+#include "../buddy/buddy.h"
+#include "../slab/slab.h"
+#include "../tcache/tcache.h"
 #include<stddef.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * The number of size class bins. Bin 'i' holds the free memory
+ * blocks with a size in the range [2^(i+3), 2^(i+4)), as memory
+ * blocks are at least 8 bytes. The last bin also holds every
+ * larger memory block.
+ */
+#define NUM_SIZE_CLASSES 32
+
+/*
+ * The size of a boundary tag. Every memory block starts with a
+ * header tag and ends with a footer tag.
+ */
+#define TAG_SIZE sizeof(Node*)
+
+/*
+ * The smallest memory block worth keeping track of, fitting both
+ * boundary tags and 8 bytes. A split that would leave a smaller
+ * residual memory block hands out the whole memory block instead.
+ */
+#define MIN_BLOCK_SIZE (2 * TAG_SIZE + 8)
+
+// A central bin holding more memory blocks than this hands a batch to the engine
+#define CENTRAL_BIN_HIGH_WATER 256
+
+// The number of memory blocks handed from a central bin to the engine at once
+#define CENTRAL_BIN_BATCH 64
+
+// The number of memory blocks an empty central bin is refilled with at once
+#define CENTRAL_BIN_REFILL 16
+
+// The number of Allocators a thread caches memory blocks of at once, each in a ThreadCache of its own
+#define THREAD_CACHE_SLOTS 4
+
+// The most metadata Nodes moved or cached memory blocks released by a single maintenance step
+#define MAINTENANCE_BUDGET 64
+
+// The size of the name buffer of a shared heap, including the terminator
+#define SHARED_NAME_SIZE 64
+
+/*
+ * The placement policies determining which free memory block
+ * an allocation is placed in.
+ */
+typedef enum {
+
+    // First fit within the segregated size class bins
+    SEGREGATED_FIT,
+
+    // The smallest memory block that fits
+    BEST_FIT,
+
+    // The smallest memory block that fits, ties broken by lowest address
+    ADDRESS_ORDERED_BEST_FIT,
+
+    // The first fitting memory block from where the previous search left off
+    NEXT_FIT
 
+} PlacementPolicy;
+
+// Defined below, the placement callbacks receive the Allocator they operate on
+struct Allocator;
+
+/*
+ * The callbacks of a placement policy, maintaining the index of
+ * free memory blocks of the Allocator passed to them. A custom
+ * placement policy keeps its index in the 'placement_state' of the
+ * Allocator. 'insert' is called when a Node becomes free and 'remove' before
+ * a free Node is taken or changes size. 'search' looks for a free
+ * Node fitting the size, boundary tags included, without removing
+ * it. 'relocate' is called after cleansing has moved the metadata
+ * of a free Node, with the Node at its old and its new location.
+ *
+ * Every built-in placement policy has a table, retrieved through
+ * placement_ops(). A custom placement policy may be plugged in
+ * through the AllocatorConfig without changing the Allocator.
+ */
 typedef struct {
+
+    void (*insert)(struct Allocator* alloc, Node* node);
+    void (*remove)(struct Allocator* alloc, Node* node);
+    Node* (*search)(struct Allocator* alloc, size_t size);
+    void (*relocate)(struct Allocator* alloc, Node* node, Node* moved_node);
+
+} PlacementOps;
+
+// The engines managing the user pool
+typedef enum {
+
+    // Metadata Nodes in the reserved pool, placed by the placement policy
+    LIST_ENGINE,
+
+    // Two-level segregated fit with inline headers and constant time operations
+    TLSF_ENGINE,
+
+    // Binary buddy system with power-of-two sized memory blocks
+    BUDDY_ENGINE
+
+} AllocatorEngine;
+
+// Where the managed heap comes from, determining how it is released
+typedef enum {
+
+    // Taken from C's built-in malloc()
+    HEAP_MALLOC,
+
+    // Anonymous memory mapped with mmap(), committed page by page once touched
+    HEAP_MMAP,
+
+    // A POSIX shared memory object mapped by several processes
+    HEAP_SHARED
+
+} HeapSource;
+
+/*
+ * Options to choose from when creating an Allocator. Retrieve
+ * the defaults with default_allocator_config() before changing
+ * the options of interest.
+ */
+typedef struct {
+
+    AllocatorEngine engine;
+
+    // Only used by the list engine
+    PlacementPolicy placement_policy;
+
+    // Replaces the table of 'placement_policy' when set, only used by the list engine
+    const PlacementOps* placement_ops;
+
+    // The state of a custom placement policy, such as its index, owned by the caller
+    void* placement_state;
+
+    // Serve objects of at most SLAB_MAX_OBJECT_SIZE bytes from slabs
+    bool use_slabs;
+
+    // Cache freed memory blocks of at most TCACHE_MAX_SIZE bytes in the thread freeing them
+    bool use_thread_cache;
+
+    // Queue the frees of threads other than the owner instead of taking the lock
+    bool use_remote_frees;
+
+    // Keep memory blocks of at most TCACHE_MAX_SIZE bytes in bins with a lock of their own
+    bool use_central_bins;
+
+    // Cache freed memory blocks of at most TCACHE_MAX_SIZE bytes in the CPU freeing them
+    bool use_cpu_cache;
+
+    // Compact the pools in a thread of their own while the Allocator is idle
+    bool use_maintenance_thread;
+
+    // The time between two maintenance steps in milliseconds
+    size_t maintenance_interval_ms;
+
+    // Reserve the managed heap with mmap() rather than malloc()
+    bool use_mmap;
+
+    // Add an extent once the managed heap is full rather than failing
+    bool use_extents;
+
+    /*
+     * Release the pages of free memory blocks of at least this many
+     * bytes to the system once as many bytes have been freed, 0 only
+     * releases them through allocator_trim().
+     */
+    size_t trim_threshold;
+
+    // The least time between two releases in milliseconds
+    size_t trim_decay_ms;
+
+    // Map allocations of at least this many bytes on their own, 0 never does
+    size_t huge_threshold;
+
+} AllocatorConfig;
+
+/*
+ * A stack of cached memory blocks of a single size class, shared
+ * by all threads and guarded by a lock of its own. The memory
+ * blocks are linked through their first word.
+ */
+typedef struct {
+
+    pthread_mutex_t lock;
+
+    void* stack;
+    size_t count;
+
+} CentralBin;
+
+/*
+ * The memory blocks cached by the threads running on a CPU. The
+ * lock is rarely contended, only by a thread migrated to another
+ * CPU in between reading its CPU and taking the lock.
+ */
+typedef struct {
+
+    pthread_mutex_t lock;
+
+    Tcache bins;
+
+} CpuCache;
+
+typedef struct Allocator {
     // Pointer to the start of the managed heap
     char* heap_start;
 
@@ -99,16 +448,168 @@ typedef struct {
     // Size of the managed heap
     size_t heap_size;
 
+    // Where the managed heap comes from
+    HeapSource heap_source;
+
+    // The name of the shared memory object of a shared heap
+    char shared_name[SHARED_NAME_SIZE];
+
     // Size of the reserved pool
     size_t reserved_pool_size;
 
     // The size of a meta data Node used for the LinkedList
     size_t meta_data_node_size;
 
+    /*
+     * Stack of the vacant metadata Nodes above the reserved pool
+     * border, linked through their next references. New metadata
+     * Nodes are placed there before the reserved pool is grown.
+     */
+    Node* vacant_slots;
+
     LinkedList* list;
 
+    // Heads of the segregated free lists, one for each size class
+    Node* bins[NUM_SIZE_CLASSES];
+
+    // Bit 'i' is set when the bin of size class 'i' is non-empty
+    size_t bin_map;
+
+    // The placement policy chosen during creation
+    PlacementPolicy placement_policy;
+
+    // The callbacks of the placement policy
+    PlacementOps placement;
+
+    // The state of a custom placement policy, handed over through the AllocatorConfig
+    void* placement_state;
+
+    // The Node the next-fit policy resumes searching at
+    Node* rover;
+
+    // Root of the size ordered tree used by the best-fit policies
+    Node* size_tree;
+
+    // Maps the start of each memory block in use to its Node
+    PointerIndex pointer_index;
+
+    // The number of memory blocks in use missing from the full pointer index
+    size_t unindexed_count;
+
+    // The engine chosen during creation
+    AllocatorEngine engine;
+
+    // The state of the TLSF engine, NULL for the other engines
+    TlsfControl* tlsf;
+
+    // The state of the buddy engine, NULL for the other engines
+    BuddyControl* buddy;
+
+    // The slabs of small objects, NULL unless enabled during creation
+    SlabCache* slabs;
+
+    // Held by the Allocator functions while they operate on the Allocator
+    pthread_mutex_t lock;
+
+    // Whether the memory blocks are cached by the threads freeing them
+    bool use_thread_cache;
+
+    // Whether small memory blocks are kept in the central bins once freed
+    bool use_central_bins;
+
+    // Whether every memory block is prefixed by a TcacheHeader
+    bool use_block_headers;
+
+    // The central bins, one for each size class of the ThreadCaches
+    CentralBin central_bins[TCACHE_CLASS_COUNT];
+
+    // The ThreadCaches holding memory blocks of the Allocator
+    struct ThreadCache* thread_caches;
+
+    // The CpuCaches in the reserved pool, one for each configured CPU
+    bool use_cpu_cache;
+    CpuCache* cpu_caches;
+    size_t cpu_cache_count;
+
+    // Whether the frees of other threads than the owner are queued
+    bool use_remote_frees;
+
+    /*
+     * The thread draining the queued frees, the creating thread unless
+     * claimed. Published with a release store, as other threads read
+     * it without the lock while another thread claims the Allocator.
+     */
+    _Atomic(pthread_t) owner_thread;
+
+    /*
+     * Stack of the memory blocks freed by other threads than the
+     * owner, linked through their first word. Pushed to without
+     * the lock, taken as a whole by the owner.
+     */
+    _Atomic(void*) remote_frees;
+
+    // Whether a maintenance thread was started during creation
+    bool use_maintenance_thread;
+    size_t maintenance_interval_ms;
+    pthread_t maintenance_thread;
+
+    // Lets destroy_allocator() wake up the maintenance thread and stop it
+    pthread_mutex_t maintenance_lock;
+    pthread_cond_t maintenance_wakeup;
+    bool maintenance_stop;
+
+    // Whether extents are added once the managed heap is full
+    bool use_extents;
+
+    /*
+     * Allocations of at least 'huge_threshold' bytes are mapped on
+     * their own. The side table maps the start of every such mapping
+     * to its length, its entries live in a mapping of their own.
+     * The side table has a lock of its own, only taken for pointers
+     * outside the managed heaps of the Allocator and its extents.
+     */
+    size_t huge_threshold;
+    PointerIndex huge_blocks;
+    pthread_mutex_t huge_lock;
+
+    // The release policy of the pages of free memory blocks
+    size_t trim_threshold;
+    size_t trim_decay_ms;
+
+    // Bytes freed since, and the monotonic time in milliseconds of, the last release
+    size_t freed_since_trim;
+    size_t last_trim_ms;
+
+    // The options of the extents, without any caches or extents of their own
+    AllocatorConfig extent_config;
+
+    /*
+     * The next extent, an Allocator of its own, each twice as large
+     * as the one before. Extents are only appended, under the lock
+     * of the first Allocator, and read without it.
+     */
+    _Atomic(struct Allocator*) next_extent;
+
 } Allocator;
 
+/*
+ * The memory blocks cached by a thread for a single Allocator. Every
+ * ThreadCache holding memory blocks is registered with its Allocator,
+ * such that destroying the Allocator can detach it.
+ */
+typedef struct ThreadCache {
+
+    Tcache bins;
+
+    // The Allocator of the cached memory blocks, NULL when detached
+    Allocator* owner;
+
+    // Neighbours in the registry of the Allocator
+    struct ThreadCache* next;
+    struct ThreadCache* prev;
+
+} ThreadCache;
+
 /*
 * @brief Given the size of the desired managed heap, an allocator
 * will be created that manages this heap. The allocator
@@ -119,15 +620,111 @@ typedef struct {
 */
 Allocator* create_allocator(size_t size);
 
+/*
+* @brief Retrieve the callbacks of a built-in placement policy.
+*
+* @param The placement policy.
+* @return The table of the placement policy.
+*/
+const PlacementOps* placement_ops(PlacementPolicy policy);
+
+/*
+* @brief Retrieve the default options for creating an Allocator.
+*
+* @return The default AllocatorConfig.
+*/
+AllocatorConfig default_allocator_config();
+
+/*
+* @brief Create an Allocator like create_allocator(), but with the
+* options given by 'config'.
+*
+* @param1 The size of the sub heap that will be allocated.
+* @param2 The options of the Allocator.
+* @return Returns a pointer to the created Allocator.
+*/
+Allocator* create_allocator_with_config(size_t size, AllocatorConfig config);
+
+/*
+* @brief Create an Allocator like create_allocator_with_config(),
+* managing a POSIX shared memory object named 'name' mapped at
+* 'address'. Thread caches, CPU caches, remote frees and the
+* maintenance thread are turned off, custom placement callbacks are
+* rejected.
+*
+* @param1 The name of the shared memory object, e.g. "/heap".
+* @param2 The address to map the managed heap at in every process.
+* @param3 The size of the managed heap.
+* @param4 The options of the Allocator.
+* @return Returns a pointer to the created Allocator, or NULL if the
+* shared memory object exists or could not be mapped at 'address'.
+*/
+Allocator* create_shared_allocator(const char* name, void* address, size_t size, AllocatorConfig config);
+
+/*
+* @brief Map the shared heap created by create_shared_allocator()
+* into the calling process, at the address it was created at.
+*
+* @param The name of the shared memory object.
+* @return The Allocator of the shared heap, or NULL if the address
+* is taken in this process.
+*/
+Allocator* attach_shared_allocator(const char* name);
+
+/*
+* @brief Unmap a shared heap from the calling process without
+* destroying it.
+*
+* @param The Allocator of the shared heap.
+*/
+void detach_shared_allocator(Allocator* alloc);
+
+/*
+* @brief Convert a pointer into the managed heap to an offset from
+* the start of the managed heap.
+*
+* @param1 The Allocator.
+* @param2 The pointer.
+* @return The offset of the pointer.
+*/
+size_t allocator_offset(Allocator* alloc, void* ptr);
+
+/*
+* @brief Convert an offset from allocator_offset() back to a pointer.
+*
+* @param1 The Allocator.
+* @param2 The offset.
+* @return The pointer at the offset.
+*/
+void* allocator_pointer(Allocator* alloc, size_t offset);
+
+/*
+* @brief Take the lock of an Allocator or central bin. The lock of a
+* shared heap is made consistent again if its holder died.
+*
+* @param The lock.
+*/
+void acquire_lock(pthread_mutex_t* lock);
+
+/*
+* @brief Take the lock like acquire_lock(), unless it is held.
+*
+* @param The lock.
+* @return Whether the lock was taken.
+*/
+bool try_acquire_lock(pthread_mutex_t* lock);
+
 /*
 * @brief Increase the reserved pool of the Allocator pointed to
 * by 'current_alloc'. This will shift and increase the Allocator's
 * member variables 'reserved_pool_border' and 'reserved_pool_size'
-* respectively with function argument 'increase'.
+* respectively with function argument 'increase'. The memory is
+* taken from the free memory block at the top of the user pool.
 *
 * @param The amount to increase the reserved pool.
+* @return Whether the reserved pool could be increased.
 */
-void increase_reserved_pool(size_t increase);
+bool increase_reserved_pool(size_t increase);
 
 /*
 * @brief Create a metadata Node and store data about the start of a
@@ -152,6 +749,27 @@ Node* create_metadata_node(char* memory_start, size_t block_size, bool is_free);
 */
 Node* merge_meta_data_nodes(LinkedList* list, Node* left_node, Node* right_node);
 
+/*
+* @brief Compact the reserved pool like cleanse_reserved_pool(),
+* moving at most 'budget' metadata Nodes. The metadata Nodes are
+* moved into vacant slots taken from the stack of vacant slots.
+* The lock of the Allocator pointed to by 'current_alloc' has to
+* be held.
+*
+* @param The largest number of metadata Nodes to move.
+* @return The number of metadata Nodes moved.
+*/
+size_t compact_reserved_pool(size_t budget);
+
+/*
+* @brief Perform a single maintenance step on an Allocator, unless
+* its lock is held by another thread. Called by the maintenance
+* thread, but may be called by any thread.
+*
+* @param The Allocator.
+*/
+void maintenance_step(Allocator* alloc);
+
 /*
 * @brief Clean the user pool by reducing memory fragment and
 * move the used memory to lower addresses in order to lower
@@ -159,6 +777,16 @@ Node* merge_meta_data_nodes(LinkedList* list, Node* left_node, Node* right_node)
 */
 void cleanse_user_pool();
 
+/*
+* @brief Release the pages of every free memory block of the
+* Allocator pointed to by 'current_alloc' and its extents to the
+* system, regardless of 'trim_threshold' and 'trim_decay_ms'. The
+* boundary tags and links in free memory blocks stay in place.
+*
+* @return The number of bytes released.
+*/
+size_t allocator_trim();
+
 /*
 * @brief Clean the reserved pool by moving the metadata to higher
 * memory addresses in order to raise the reserved pool border.
@@ -183,6 +811,98 @@ void* allocator_malloc(size_t required_size);
 */
 Node* naive_search(size_t size);
 
+/*
+* @brief Retrieve the size class of a memory block size, derived
+* from the position of its highest set bit.
+*
+* @param The memory block size.
+* @return The index of the bin for the memory block size.
+*/
+size_t size_class(size_t size);
+
+/*
+* @brief Insert a Node with a free memory block into the
+* bin corresponding to the size class of the memory block.
+*
+* @param1 The Allocator.
+* @param2 The Node to be inserted.
+*/
+void bin_insert(Allocator* alloc, Node* node);
+
+/*
+* @brief Remove a Node from the bin it currently resides in.
+*
+* @param1 The Allocator.
+* @param2 The Node to be removed.
+*/
+void bin_remove(Allocator* alloc, Node* node);
+
+/*
+* @brief Search the ring of free Nodes of the next-fit policy for
+* a Node with an available memory block fitting 'size'. The search
+* starts at the rover, which is left at the Node found.
+*
+* @param1 The Allocator.
+* @param2 The size requirement for the memory block.
+* @return A Node with a memory block fitting the size requirement.
+*/
+Node* next_fit_search(Allocator* alloc, size_t size);
+
+/*
+* @brief Insert a Node with a free memory block into the free
+* memory block index of the placement policy.
+*
+* @param The Node to be inserted.
+*/
+void free_index_insert(Node* node);
+
+/*
+* @brief Remove a Node from the free memory block index of the
+* placement policy.
+*
+* @param The Node to be removed.
+*/
+void free_index_remove(Node* node);
+
+/*
+* @brief Search the free memory block index of the placement
+* policy for a Node with an available memory block fitting 'size'.
+*
+* @param The size requirement for the memory block.
+* @return A Node with a memory block fitting the size requirement.
+*/
+Node* free_index_search(size_t size);
+
+/*
+* @brief Search the size class bins for a Node with an available
+* memory block fitting 'size'. Only the bin of the matching size
+* class is scanned, any larger non-empty bin is guaranteed to fit.
+*
+* @param1 The Allocator.
+* @param2 The size requirement for the memory block.
+* @return A Node with a memory block fitting the size requirement.
+*/
+Node* bin_search(Allocator* alloc, size_t size);
+
+/*
+* @brief Write the boundary tags of the memory block of a Node,
+* referencing the Node. Called whenever the memory block or
+* the Node itself moves.
+*
+* @param The Node of the memory block.
+*/
+void write_boundary_tags(Node* node);
+
+/*
+* @brief Retrieve the metadata Node of a pointer handed out by
+* allocator_malloc() through the pointer index.
+*
+* @param The pointer handed out to the user.
+* @return The corresponding Node, or NULL if the pointer was not
+* handed out by the Allocator.
+*/
+Node* retrieve_node(void* ptr);
+
 /*
 * @brief Free up the memory corresponding to the pointer.
 *
@@ -204,10 +924,96 @@ void allocator_free(void* ptr);
 */
 void* allocator_realloc(void* ptr, size_t size);
 
+/*
+* @brief Make the calling thread the owner of the Allocator, draining
+* the frees queued by other threads. May be called while other threads
+* free memory of the Allocator, from then on the previous owner queues
+* its frees like any other thread.
+*
+* @param The Allocator.
+*/
+void claim_allocator(Allocator* alloc);
+
+/*
+* @brief Allocate memory like allocator_malloc(), but from the
+* Allocator 'alloc' instead of the one pointed to by 'current_alloc'.
+*
+* @param1 The Allocator to allocate from.
+* @param2 Determines the required size of memory to allocate.
+* @return Returns a pointer to the allocated memory.
+*/
+void* allocator_malloc_from(Allocator* alloc, size_t required_size);
+
+/*
+* @brief Free memory like allocator_free(), but to the Allocator
+* 'alloc' instead of the one pointed to by 'current_alloc'.
+*
+* @param1 The Allocator the memory was allocated from.
+* @param2 Pointer to the object to be freed.
+*/
+void allocator_free_to(Allocator* alloc, void* ptr);
+
+/*
+* @brief Reallocate memory like allocator_realloc(), but within the
+* Allocator 'alloc' instead of the one pointed to by 'current_alloc'.
+*
+* @param1 The Allocator the memory was allocated from.
+* @param2 The pointer pointing to the memory we want to reallocate.
+* @param3 The desired size of the memory block when reallocating.
+* @return A pointer to the memory address where the reallocated
+* memory block starts.
+*/
+void* allocator_realloc_in(Allocator* alloc, void* ptr, size_t size);
+
+/*
+* @brief Retrieve the number of bytes usable at a pointer handed out
+* by the Allocator pointed to by 'current_alloc', which may exceed
+* the size requested.
+*
+* @param The pointer to the memory block.
+* @return The usable size, or 0 if 'ptr' is not in use.
+*/
+size_t allocator_usable_size(void* ptr);
+
+/*
+* @brief Retrieve the usable size like allocator_usable_size(), but
+* of a pointer handed out by the Allocator 'alloc'.
+*
+* @param1 The Allocator the memory was allocated from.
+* @param2 The pointer to the memory block.
+* @return The usable size, or 0 if 'ptr' is not in use.
+*/
+size_t allocator_usable_size_in(Allocator* alloc, void* ptr);
+
+/*
+* @brief Find the Allocator managing a pointer among an Allocator
+* and its extents.
+*
+* @param1 The Allocator.
+* @param2 The pointer.
+* @return The Allocator or extent whose managed heap holds 'ptr',
+* or NULL if none does.
+*/
+Allocator* extent_of(Allocator* alloc, void* ptr);
+
+/*
+* @brief Retrieve the length of the mapping of a huge memory block of
+* an Allocator. Takes the lock of the side table, thus only meant for
+* pointers outside the managed heaps of the Allocator and its extents.
+*
+* @param1 The Allocator.
+* @param2 The pointer.
+* @return The length of the mapping, or 0 if 'ptr' is not a huge
+* memory block of the Allocator.
+*/
+size_t huge_block_size(Allocator* alloc, void* ptr);
+
 /*
 * $brief Destory the Allocator pointed to by 'current_alloc' and its
 * corresonding metadata. Then free the managed heap from memory by
-* calling C's built-in free().
+* calling C's built-in free(). A heap created with 'use_mmap' is
+* unmapped instead, a shared heap is unmapped and its shared memory
+* object removed.
 */
 void destroy_allocator();
 
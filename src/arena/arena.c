@@ -0,0 +1,210 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include "arena.h"
+
+// The ArenaManager the thread was last assigned an arena of
+static _Thread_local ArenaManager* assigned_manager = NULL;
+
+// The index of the arena assigned to the thread
+static _Thread_local size_t assigned_arena = 0;
+
+/*
+ * @brief Order arenas by the address of their managed heap.
+ *
+ * @param1 The first arena.
+ * @param2 The second arena.
+ * @return A negative, zero or positive value as for qsort().
+ */
+int compare_arenas(const void* first, const void* second) {
+
+    char* first_start = (*(Allocator* const*) first)->heap_start;
+    char* second_start = (*(Allocator* const*) second)->heap_start;
+
+    return (first_start > second_start) - (first_start < second_start);
+
+}
+
+ArenaManager* create_arena_manager(size_t arena_count, size_t heap_size, AllocatorConfig config) {
+
+    if (arena_count == 0) {
+
+        long processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+        arena_count = processor_count > 0 ? (size_t) processor_count : 1;
+
+    }
+
+    ArenaManager* manager = (ArenaManager*) malloc(sizeof(ArenaManager));
+    Allocator** arenas = (Allocator**) malloc(arena_count * sizeof(Allocator*));
+
+    if (manager == NULL || arenas == NULL) {
+
+        free(manager);
+        free(arenas);
+        return NULL;
+
+    }
+
+    manager->arenas = arenas;
+    manager->arena_count = 0;
+    atomic_init(&manager->next_arena, 0);
+
+    for (size_t i = 0; i < arena_count; i++) {
+
+        arenas[i] = create_allocator_with_config(heap_size, config);
+
+        if (arenas[i] == NULL) {
+
+            // Tear down the arenas created so far
+            destroy_arena_manager(manager);
+            return NULL;
+
+        }
+
+        manager->arena_count++;
+
+    }
+
+    qsort(arenas, arena_count, sizeof(Allocator*), compare_arenas);
+
+    return manager;
+
+}
+
+void destroy_arena_manager(ArenaManager* manager) {
+
+    if (manager == NULL) { return; }
+
+    for (size_t i = 0; i < manager->arena_count; i++) {
+
+        // Destroying an Allocator requires it to be the current one
+        set_allocator(manager->arenas[i]);
+        destroy_allocator();
+        release_allocator();
+
+    }
+
+    if (assigned_manager == manager) { assigned_manager = NULL; }
+
+    free(manager->arenas);
+    free(manager);
+
+}
+
+Allocator* arena_of(ArenaManager* manager, void* ptr) {
+
+    char* location = (char*) ptr;
+
+    // Binary search for the last arena starting at or below 'ptr'
+    size_t low = 0;
+    size_t high = manager->arena_count;
+
+    while (low < high) {
+
+        size_t middle = low + (high - low) / 2;
+
+        if (manager->arenas[middle]->heap_start <= location) {
+
+            low = middle + 1;
+
+        } else {
+
+            high = middle;
+
+        }
+
+    }
+
+    if (low > 0 && location < manager->arenas[low - 1]->heap_end) {
+
+        return manager->arenas[low - 1];
+
+    }
+
+    // The extents of the arenas lie anywhere, they are searched one by one
+    for (size_t i = 0; i < manager->arena_count; i++) {
+
+        if (manager->arenas[i]->use_extents && extent_of(manager->arenas[i], ptr)) {
+
+            return manager->arenas[i];
+
+        }
+
+    }
+
+    // Any other pointer may still be a huge memory block mapped by an arena
+    for (size_t i = 0; i < manager->arena_count; i++) {
+
+        if (huge_block_size(manager->arenas[i], ptr) != 0) {
+
+            return manager->arenas[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+void* arena_malloc(ArenaManager* manager, size_t size) {
+
+    if (assigned_manager != manager || assigned_arena >= manager->arena_count) {
+
+        // Assign the arenas round-robin to the threads
+        assigned_manager = manager;
+        assigned_arena = atomic_fetch_add(&manager->next_arena, 1) % manager->arena_count;
+
+    }
+
+    Allocator* arena = manager->arenas[assigned_arena];
+
+    /*
+     * Rather than waiting for another thread to release the arena,
+     * move on to the next one and stay there. The lock is only probed
+     * for contention, allocator_malloc_from() takes it on its own when
+     * needed, thus the fast paths of the caches stay free of it.
+     */
+    for (size_t tried = 1; !try_acquire_lock(&arena->lock); tried++) {
+
+        if (tried == manager->arena_count) {
+
+            // Every arena is contended, stay on this one
+            return allocator_malloc_from(arena, size);
+
+        }
+
+        assigned_arena = (assigned_arena + 1) % manager->arena_count;
+        arena = manager->arenas[assigned_arena];
+
+    }
+
+    pthread_mutex_unlock(&arena->lock);
+
+    return allocator_malloc_from(arena, size);
+
+}
+
+void arena_free(ArenaManager* manager, void* ptr) {
+
+    Allocator* arena = arena_of(manager, ptr);
+
+    if (arena == NULL) {
+
+        // Not a pointer of any arena, ignore it
+        return;
+
+    }
+
+    allocator_free_to(arena, ptr);
+
+}
+
+void* arena_realloc(ArenaManager* manager, void* ptr, size_t size) {
+
+    Allocator* arena = arena_of(manager, ptr);
+
+    if (arena == NULL) { return NULL; }
+
+    return allocator_realloc_in(arena, ptr, size);
+
+}
@@ -0,0 +1,92 @@
+/**
+ * @file arena.h
+ * @brief Several Allocators (arenas) shared by the threads of a process.
+ *
+ * @details
+ * An ArenaManager creates a fixed number of Allocators, by default
+ * one for every online processor. Every thread is assigned an arena
+ * round-robin on its first allocation and keeps allocating from it.
+ * Should the lock of its arena be held by another thread, the thread
+ * moves on to the next arena instead of waiting, spreading the threads
+ * over the arenas by contention.
+ *
+ * A memory block may be freed or reallocated by any thread. The arena
+ * owning a pointer is found by comparing it with the managed heaps of
+ * the arenas, sorted by address, rather than through any per-thread
+ * state. Reallocation stays within the owning arena.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdatomic.h>
+#include "../allocator/allocator.h"
+
+typedef struct {
+
+    // The arenas, sorted by the address of their managed heap
+    Allocator** arenas;
+    size_t arena_count;
+
+    // The arena assigned to the next thread, modulo 'arena_count'
+    atomic_size_t next_arena;
+
+} ArenaManager;
+
+/*
+* @brief Create an ArenaManager along with its arenas.
+*
+* @param1 The number of arenas, 0 for one arena per online processor.
+* @param2 The size of the managed heap of every arena.
+* @param3 The options every arena is created with.
+* @return The ArenaManager, or NULL if an arena could not be created.
+*/
+ArenaManager* create_arena_manager(size_t arena_count, size_t heap_size, AllocatorConfig config);
+
+/*
+* @brief Destroy the ArenaManager and all of its arenas. The
+* thread is left without a current Allocator afterwards.
+*
+* @param The ArenaManager.
+*/
+void destroy_arena_manager(ArenaManager* manager);
+
+/*
+* @brief Retrieve the arena owning a pointer.
+*
+* @param1 The ArenaManager.
+* @param2 The pointer.
+* @return The arena whose managed heap or extents contain 'ptr', or
+* which mapped 'ptr' as a huge memory block, or NULL.
+*/
+Allocator* arena_of(ArenaManager* manager, void* ptr);
+
+/*
+* @brief Allocate memory from the arena assigned to the thread.
+*
+* @param1 The ArenaManager.
+* @param2 The required size of the memory block.
+* @return A pointer to the memory block, or NULL if the arena is full.
+*/
+void* arena_malloc(ArenaManager* manager, size_t size);
+
+/*
+* @brief Free memory to the arena owning it.
+*
+* @param1 The ArenaManager.
+* @param2 A pointer returned by arena_malloc() or arena_realloc().
+*/
+void arena_free(ArenaManager* manager, void* ptr);
+
+/*
+* @brief Reallocate memory within the arena owning it.
+*
+* @param1 The ArenaManager.
+* @param2 A pointer returned by arena_malloc() or arena_realloc().
+* @param3 The desired size of the memory block.
+* @return A pointer to the reallocated memory block, or NULL if it
+* could not be reallocated.
+*/
+void* arena_realloc(ArenaManager* manager, void* ptr, size_t size);
+
+#endif // ARENA_H
@@ -0,0 +1,336 @@
+#include <stdint.h>
+#include <string.h>
+#include "buddy.h"
+
+// The header preceding every memory block, the free list links are not part of it
+#define BUDDY_HEADER_SIZE offsetof(BuddyBlock, next_free)
+
+/*
+ * @brief Retrieve the size of the memory blocks of an order.
+ *
+ * @param The order.
+ * @return The size of the memory blocks including their header.
+ */
+size_t buddy_order_size(size_t order) {
+
+    return BUDDY_MIN_BLOCK_SIZE << order;
+
+}
+
+/*
+ * @brief Determine the smallest order fitting 'size' bytes
+ * along with the header.
+ *
+ * @param The requested size.
+ * @return The order, BUDDY_ORDER_COUNT if no order is large enough.
+ */
+size_t buddy_order_of(size_t size) {
+
+    size_t order = 0;
+
+    while (order < BUDDY_ORDER_COUNT && buddy_order_size(order) - BUDDY_HEADER_SIZE < size) {
+
+        order++;
+
+    }
+
+    return order;
+
+}
+
+/*
+ * @brief Push a memory block on the free list of its order.
+ *
+ * @param1 The BuddyControl.
+ * @param2 The memory block.
+ */
+void buddy_insert_block(BuddyControl* control, BuddyBlock* block) {
+
+    BuddyBlock* head = control->free_lists[block->order];
+
+    block->is_free = true;
+    block->prev_free = NULL;
+    block->next_free = head;
+
+    if (head) {
+
+        head->prev_free = block;
+
+    }
+
+    control->free_lists[block->order] = block;
+    control->order_map |= (size_t) 1 << block->order;
+
+}
+
+/*
+ * @brief Unlink a memory block from the free list of its order.
+ *
+ * @param1 The BuddyControl.
+ * @param2 The memory block.
+ */
+void buddy_remove_block(BuddyControl* control, BuddyBlock* block) {
+
+    if (block->prev_free) {
+
+        block->prev_free->next_free = block->next_free;
+
+    } else {
+
+        control->free_lists[block->order] = block->next_free;
+
+    }
+
+    if (block->next_free) {
+
+        block->next_free->prev_free = block->prev_free;
+
+    }
+
+    if (control->free_lists[block->order] == NULL) {
+
+        control->order_map &= ~((size_t) 1 << block->order);
+
+    }
+
+    block->is_free = false;
+
+}
+
+/*
+ * @brief Retrieve the buddy of a memory block by flipping the bit
+ * of its order in the offset from the start of the pool.
+ *
+ * @param1 The BuddyControl.
+ * @param2 The memory block.
+ * @return The buddy, or NULL if it reaches beyond the pool.
+ */
+BuddyBlock* buddy_of(BuddyControl* control, BuddyBlock* block) {
+
+    size_t size = buddy_order_size(block->order);
+    size_t offset = ((char*) block - control->pool_start) ^ size;
+
+    if (offset + size > control->pool_size) { return NULL; }
+
+    return (BuddyBlock*) (control->pool_start + offset);
+
+}
+
+/*
+ * @brief Split a memory block in halves until it is of 'order',
+ * pushing the upper halves on their free lists.
+ *
+ * @param1 The BuddyControl.
+ * @param2 The memory block, not part of any free list.
+ * @param3 The order to split the memory block down to.
+ */
+void buddy_split_block(BuddyControl* control, BuddyBlock* block, size_t order) {
+
+    while (block->order > order) {
+
+        block->order--;
+
+        BuddyBlock* upper = (BuddyBlock*) ((char*) block + buddy_order_size(block->order));
+        upper->order = block->order;
+        buddy_insert_block(control, upper);
+
+    }
+
+}
+
+/*
+ * @brief Retrieve the header of the memory block in use at 'ptr'.
+ * The header has to be of a valid order and the memory block has
+ * to be aligned to its size within the pool.
+ *
+ * @param1 The BuddyControl.
+ * @param2 The pointer to verify.
+ * @return The memory block, or NULL if 'ptr' is not in use.
+ */
+BuddyBlock* buddy_used_block(BuddyControl* control, void* ptr) {
+
+    char* payload = (char*) ptr;
+
+    if (payload < control->pool_start + BUDDY_HEADER_SIZE
+        || payload >= control->pool_start + control->pool_size) {
+
+        return NULL;
+
+    }
+
+    BuddyBlock* block = (BuddyBlock*) (payload - BUDDY_HEADER_SIZE);
+    size_t offset = (char*) block - control->pool_start;
+
+    if (offset % BUDDY_MIN_BLOCK_SIZE != 0 || block->is_free || block->order >= BUDDY_ORDER_COUNT) {
+
+        return NULL;
+
+    }
+
+    size_t size = buddy_order_size(block->order);
+
+    if (offset % size != 0 || offset + size > control->pool_size) { return NULL; }
+
+    return block;
+
+}
+
+bool buddy_init(BuddyControl* control, char* pool_start, size_t pool_size) {
+
+    pool_size &= ~(BUDDY_MIN_BLOCK_SIZE - 1);
+
+    if (pool_size == 0) { return false; }
+
+    for (size_t i = 0; i < BUDDY_ORDER_COUNT; i++) {
+
+        control->free_lists[i] = NULL;
+
+    }
+
+    control->order_map = 0;
+    control->pool_start = pool_start;
+    control->pool_size = pool_size;
+
+    /*
+     * Cover the pool with the largest memory blocks that fit. As the
+     * sizes only decrease, every memory block is aligned to its size.
+     */
+    size_t offset = 0;
+
+    while (offset < pool_size) {
+
+        size_t order = BUDDY_ORDER_COUNT - 1;
+
+        while (buddy_order_size(order) > pool_size - offset) {
+
+            order--;
+
+        }
+
+        BuddyBlock* block = (BuddyBlock*) (pool_start + offset);
+        block->order = order;
+        buddy_insert_block(control, block);
+
+        offset += buddy_order_size(order);
+
+    }
+
+    return true;
+
+}
+
+void* buddy_malloc(BuddyControl* control, size_t size) {
+
+    size_t order = buddy_order_of(size);
+
+    if (order >= BUDDY_ORDER_COUNT) { return NULL; }
+
+    // Find the smallest non-empty free list of a large enough order
+    size_t order_map = control->order_map & (~(size_t) 0 << order);
+
+    if (!order_map) {
+
+        // No free memory block is large enough
+        return NULL;
+
+    }
+
+    BuddyBlock* block = control->free_lists[__builtin_ctzl(order_map)];
+
+    buddy_remove_block(control, block);
+    buddy_split_block(control, block, order);
+
+    return (char*) block + BUDDY_HEADER_SIZE;
+
+}
+
+bool buddy_free(BuddyControl* control, void* ptr) {
+
+    BuddyBlock* block = buddy_used_block(control, ptr);
+
+    if (block == NULL) {
+
+        // Not a memory block in use, ignore it
+        return false;
+
+    }
+
+    // Merge with the buddy for as long as it is free and whole
+    BuddyBlock* buddy = buddy_of(control, block);
+
+    while (buddy && buddy->is_free && buddy->order == block->order) {
+
+        buddy_remove_block(control, buddy);
+
+        // The merged memory block starts at the lower buddy
+        BuddyBlock* upper = buddy < block ? block : buddy;
+        if (buddy < block) { block = buddy; }
+
+        // Invalidate the absorbed header, so it cannot be freed again
+        upper->order = BUDDY_ORDER_COUNT;
+
+        block->order++;
+        buddy = block->order < BUDDY_ORDER_COUNT - 1 ? buddy_of(control, block) : NULL;
+
+    }
+
+    buddy_insert_block(control, block);
+
+    return true;
+
+}
+
+void* buddy_realloc(BuddyControl* control, void* ptr, size_t size) {
+
+    BuddyBlock* block = buddy_used_block(control, ptr);
+
+    if (block == NULL) { return NULL; }
+
+    // Reallocating to 0 bytes is the same as freeing the memory block
+    if (size == 0) { buddy_free(control, ptr); return NULL; }
+
+    size_t order = buddy_order_of(size);
+
+    if (order >= BUDDY_ORDER_COUNT) { return NULL; }
+
+    if (order <= block->order) {
+
+        // Give back the unneeded upper halves
+        buddy_split_block(control, block, order);
+        return ptr;
+
+    }
+
+    // Move the contents to a new memory block
+    void* new_ptr = buddy_malloc(control, size);
+
+    if (new_ptr == NULL) { return NULL; }
+
+    memcpy(new_ptr, ptr, buddy_order_size(block->order) - BUDDY_HEADER_SIZE);
+    buddy_free(control, ptr);
+
+    return new_ptr;
+
+}
+
+size_t buddy_usable_size(BuddyControl* control, void* ptr) {
+
+    BuddyBlock* block = buddy_used_block(control, ptr);
+
+    return block ? buddy_order_size(block->order) - BUDDY_HEADER_SIZE : 0;
+
+}
+
+void buddy_for_each_free(BuddyControl* control, void (*visit)(char* start, char* end, void* context), void* context) {
+
+    for (size_t i = 0; i < BUDDY_ORDER_COUNT; i++) {
+
+        for (BuddyBlock* block = control->free_lists[i]; block; block = block->next_free) {
+
+            visit((char*) block + sizeof(BuddyBlock), (char*) block + buddy_order_size(block->order), context);
+
+        }
+
+    }
+
+}
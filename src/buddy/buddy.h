@@ -0,0 +1,136 @@
+/**
+ * @file buddy.h
+ * @brief Binary buddy memory pool.
+ *
+ * @details
+ * A BuddyControl manages a single contiguous memory pool split into
+ * memory blocks of power-of-two sizes, each starting with an inline
+ * BuddyBlock header. A memory block of order 'k' spans
+ * BUDDY_MIN_BLOCK_SIZE << k bytes and starts at an offset from the
+ * start of the pool that is a multiple of its size. Its buddy, the
+ * other half of the memory block it was split from, is therefore
+ * found by flipping a single bit of that offset.
+ *
+ * The free memory blocks are kept in a free list for each order. An
+ * allocation splits the smallest large enough free memory block in
+ * halves until it fits, and a free merges the memory block with its
+ * buddy for as long as the buddy is free and of the same order. Both
+ * take at most one step per order, without searching.
+ *
+ * A pool that is not a power of two in size is covered by the largest
+ * possible memory blocks from its start onwards. Buddies reaching
+ * beyond the end of the pool are never merged with.
+ *
+ * Like the PointerIndex, the BuddyControl does not allocate any
+ * memory by itself, both the BuddyControl and the pool are handed
+ * over during initialization.
+ */
+
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// The size of the memory blocks of order 0 is 2^BUDDY_MIN_BLOCK_LOG2
+#define BUDDY_MIN_BLOCK_LOG2 5
+#define BUDDY_MIN_BLOCK_SIZE ((size_t) 1 << BUDDY_MIN_BLOCK_LOG2)
+
+// The number of orders, memory blocks are smaller than 2^40 bytes
+#define BUDDY_ORDER_COUNT (40 - BUDDY_MIN_BLOCK_LOG2)
+
+typedef struct BuddyBlock {
+
+    // The order of the memory block
+    unsigned int order;
+
+    // Whether the memory block is in a free list
+    unsigned int is_free;
+
+    /*
+     * The links of the free list. They overlap the start of the
+     * memory block, thus they are only valid for free blocks.
+     */
+    struct BuddyBlock* next_free;
+    struct BuddyBlock* prev_free;
+
+} BuddyBlock;
+
+typedef struct {
+
+    // Heads of the free lists, one for each order
+    BuddyBlock* free_lists[BUDDY_ORDER_COUNT];
+
+    // Bit 'k' is set when the free list of order 'k' is non-empty
+    size_t order_map;
+
+    // The memory pool being managed
+    char* pool_start;
+    size_t pool_size;
+
+} BuddyControl;
+
+/*
+* @brief Initialize a BuddyControl managing the memory pool at
+* 'pool_start', covering the pool with free memory blocks.
+*
+* @param1 The BuddyControl to initialize.
+* @param2 The start of the memory pool, aligned to 8 bytes.
+* @param3 The size of the memory pool.
+* @return Whether the pool fits at least a single memory block.
+*/
+bool buddy_init(BuddyControl* control, char* pool_start, size_t pool_size);
+
+/*
+* @brief Allocate a memory block of at least 'size' bytes.
+*
+* @param1 The BuddyControl.
+* @param2 The requested size.
+* @return A pointer to the memory block, or NULL if no free
+* memory block is large enough.
+*/
+void* buddy_malloc(BuddyControl* control, size_t size);
+
+/*
+* @brief Free the memory block at 'ptr' and merge it with its buddies.
+*
+* @param1 The BuddyControl.
+* @param2 A pointer returned by buddy_malloc() or buddy_realloc().
+* @return Whether 'ptr' was an allocated memory block.
+*/
+bool buddy_free(BuddyControl* control, void* ptr);
+
+/*
+* @brief Resize the memory block at 'ptr'. Shrinking splits off the
+* unneeded halves in place, otherwise the contents are moved to a
+* new memory block when the current one is too small.
+*
+* @param1 The BuddyControl.
+* @param2 A pointer returned by buddy_malloc() or buddy_realloc().
+* @param3 The new size, a size of 0 frees the memory block.
+* @return A pointer to the resized memory block, or NULL if it
+* could not be resized, leaving the memory block untouched.
+*/
+void* buddy_realloc(BuddyControl* control, void* ptr, size_t size);
+
+/*
+* @brief Retrieve the number of bytes usable at 'ptr'.
+*
+* @param1 The BuddyControl.
+* @param2 A pointer returned by buddy_malloc() or buddy_realloc().
+* @return The size of the memory block without its header, or 0 if
+* it is not in use.
+*/
+size_t buddy_usable_size(BuddyControl* control, void* ptr);
+
+/*
+* @brief Visit every free memory block with the range of its memory
+* not holding the BuddyBlock, which may be discarded.
+*
+* @param1 The BuddyControl.
+* @param2 Called with the start and end of the range and 'context'.
+* @param3 Handed over to every call of 'visit'.
+*/
+void buddy_for_each_free(BuddyControl* control, void (*visit)(char* start, char* end, void* context), void* context);
+
+#endif // BUDDY_H
@@ -43,6 +43,7 @@ LinkedList* add(LinkedList* list, Node* node) {
         list->tail = node;
 
         node->next = NULL;
+        node->prev = NULL;
 
         list->size++;
         node->id = list->next_id++;
@@ -54,9 +55,10 @@ LinkedList* add(LinkedList* list, Node* node) {
         // Overwrite tail node
         list->tail = node;
 
-        // Update next Node references
+        // Update next and previous Node references
         tail_node->next = node;
         node->next = NULL;
+        node->prev = tail_node;
 
         list->size++;
         node->id = list->next_id++;
@@ -67,6 +69,38 @@ LinkedList* add(LinkedList* list, Node* node) {
 
 }
 
+LinkedList* insert_after(LinkedList* list, Node* node, Node* new_node) {
+
+    if (list == NULL || node == NULL || new_node == NULL) {
+
+        // There is nothing to operate on
+        return NULL;
+
+    }
+
+    // Update next and previous Node references
+    new_node->next = node->next;
+    new_node->prev = node;
+    node->next = new_node;
+
+    if (list->tail == node) {
+
+        // Inserting after the tail makes the new Node the tail
+        list->tail = new_node;
+
+    } else {
+
+        new_node->next->prev = new_node;
+
+    }
+
+    list->size++;
+    new_node->id = list->next_id++;
+
+    return list;
+
+}
+
 LinkedList* delete_node(LinkedList* list, size_t id) {
 
     Node* dropped_node = drop_node(list, id);
@@ -102,6 +136,7 @@ Node* drop_node(LinkedList* list, size_t id) {
         // The head is the Node
         Node* dropped_node = list->head;
         list->head = list->head->next;
+        list->head->prev = NULL;
         list->size -= 1;
 
         return dropped_node;
@@ -132,6 +167,7 @@ Node* drop_node(LinkedList* list, size_t id) {
             } else {
 
                 prev_node->next = node->next;
+                node->next->prev = prev_node;
 
             }
 
@@ -150,6 +186,40 @@ Node* drop_node(LinkedList* list, size_t id) {
 
 }
 
+Node* remove_node(LinkedList* list, Node* node) {
+
+    if (!list || !node) { return NULL; }
+
+    // Bypass the Node in the chain of next references
+    if (node->prev) {
+
+        node->prev->next = node->next;
+
+    } else {
+
+        list->head = node->next;
+
+    }
+
+    // Bypass the Node in the chain of previous references
+    if (node->next) {
+
+        node->next->prev = node->prev;
+
+    } else {
+
+        list->tail = node->prev;
+
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    list->size -= 1;
+
+    return node;
+
+}
+
 size_t search_by_value(LinkedList* list, void* data, size_t data_size) {
 
     if (data == NULL || data_size == 0) {
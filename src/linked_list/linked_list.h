@@ -44,6 +44,16 @@ LinkedList* create_list();
 */
 LinkedList* add(LinkedList* list, Node* node);
 
+/*
+* @brief Insert a node directly after a node already in the list.
+*
+* @param1 The linked list to insert the node into.
+* @param2 The node in the list to insert after.
+* @param3 The node to be inserted.
+* @return Return pointer to the list.
+*/
+LinkedList* insert_after(LinkedList* list, Node* node, Node* new_node);
+
 /*
 * @brief Delete a node from the list with ID
 * corresponding to 'id'.
@@ -71,6 +81,19 @@ LinkedList* delete_node(LinkedList* list, size_t id);
 */
 Node* drop_node(LinkedList* list, size_t id);
 
+/*
+* @brief Remove a node from the list in constant time by
+* using its references to the previous and next node.
+*
+* $note This will not free the Node from the heap,
+* only remove it from the LinkedList.
+*
+* @param1 The LinkedList.
+* @param2 The node to be removed, must be in the list.
+* @return Returns a pointer to the Node that was removed.
+*/
+Node* remove_node(LinkedList* list, Node* node);
+
 /*
 * @brief Search by value in the linked list. The function
 * looks through the nodes and find the first Node
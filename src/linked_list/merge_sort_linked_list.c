@@ -104,11 +104,13 @@ LinkedList* merge_sort_list(LinkedList* list) {
 
     // Update the head
     list->head = sorted_head;
+    sorted_head->prev = NULL;
 
-    // Retrieve the new tail
+    // Retrieve the new tail while restoring the previous Node references
     Node* node = sorted_head;
     while (node->next != NULL) {
 
+        node->next->prev = node;
         node = node->next;
 
     }
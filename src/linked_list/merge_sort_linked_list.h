@@ -27,7 +27,8 @@ Node* merge(Node* left, Node* right);
 
 /*
 * @brief Perform the merge sort algorithm on the next
-* reference chain strating from Node head.
+* reference chain strating from Node head. The previous
+* Node references are left untouched.
 *
 * @param The head Node of the corresponding LinkedList
 * to be sorted.
@@ -32,6 +32,7 @@ Node* create_node(void* data, size_t data_size) {
     // Initialize the other members
     node->data_size = data_size;
     node->next = NULL;
+    node->prev = NULL;
     node->id = 0;
 
     return node;
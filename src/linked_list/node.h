@@ -12,6 +12,9 @@ typedef struct Node {
     // reference to the next Node. Used by the linked list
     struct Node* next;
 
+    // reference to the previous Node. Used by the linked list
+    struct Node* prev;
+
     /*
     * ID of the node used by the linked list. Starts at 1.
     * When a Node is inserted into a LinkedList, the list
@@ -4,6 +4,10 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+// Forward declaration used to reference Node
+// without having to include the whole header file.
+typedef struct Node Node;
+
 typedef struct {
 
     // Points to the start of a memory block
@@ -25,6 +29,31 @@ typedef struct {
      */
     bool in_use;
 
+    /*
+     * Links of the free memory block index of the Allocator.
+     * Only meaningful while the memory block is free, as the
+     * index exclusively holds free memory blocks. Which links
+     * are used depends on the placement policy.
+     */
+    union {
+
+        // Neighbouring Nodes within the same size class bin
+        struct {
+            Node* prev_free;
+            Node* next_free;
+        };
+
+        // Children within the size ordered tree
+        struct {
+            Node* left_free;
+            Node* right_free;
+        };
+
+    };
+
+    // Height of the subtree rooted at this Node in the size ordered tree
+    size_t tree_height;
+
 } MemoryData;
 
 /*
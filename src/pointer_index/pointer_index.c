@@ -0,0 +1,158 @@
+#include <stdint.h>
+#include "pointer_index.h"
+
+/*
+ * @brief Hash a pointer into an entry position. The low bits of a
+ * pointer are mostly zero due to alignment, therefore Fibonacci
+ * hashing is used to spread the high bits over the position.
+ *
+ * @param1 The PointerIndex.
+ * @param2 The key.
+ * @return The position of the first entry to probe.
+ */
+size_t pointer_index_position(PointerIndex* index, void* key) {
+
+    uint64_t hash = (uint64_t) (uintptr_t) key * 0x9E3779B97F4A7C15ull;
+
+    return (size_t) (hash >> 32) & (index->capacity - 1);
+
+}
+
+void pointer_index_init(PointerIndex* index, PointerIndexEntry* entries, size_t capacity) {
+
+    index->entries = entries;
+    index->capacity = capacity;
+    index->size = 0;
+
+    for (size_t i = 0; i < capacity; i++) {
+
+        entries[i].key = NULL;
+        entries[i].value = NULL;
+
+    }
+
+}
+
+void pointer_index_init_zeroed(PointerIndex* index, PointerIndexEntry* entries, size_t capacity) {
+
+    index->entries = entries;
+    index->capacity = capacity;
+    index->size = 0;
+
+}
+
+bool pointer_index_insert(PointerIndex* index, void* key, void* value) {
+
+    if (key == NULL || index->capacity == 0) { return false; }
+
+    size_t mask = index->capacity - 1;
+    size_t position = pointer_index_position(index, key);
+
+    // Probe until the key or an empty entry is found
+    while (index->entries[position].key != NULL) {
+
+        if (index->entries[position].key == key) {
+
+            // The key is already present, overwrite the value
+            index->entries[position].value = value;
+            return true;
+
+        }
+
+        position = (position + 1) & mask;
+
+    }
+
+    // Keep a quarter of the entries empty
+    if (4 * (index->size + 1) > 3 * index->capacity) {
+
+        return false;
+
+    }
+
+    index->entries[position].key = key;
+    index->entries[position].value = value;
+    index->size++;
+
+    return true;
+
+}
+
+void* pointer_index_lookup(PointerIndex* index, void* key) {
+
+    if (key == NULL || index->capacity == 0) { return NULL; }
+
+    size_t mask = index->capacity - 1;
+    size_t position = pointer_index_position(index, key);
+
+    while (index->entries[position].key != NULL) {
+
+        if (index->entries[position].key == key) {
+
+            return index->entries[position].value;
+
+        }
+
+        position = (position + 1) & mask;
+
+    }
+
+    // Reached an empty entry, the key is not present
+    return NULL;
+
+}
+
+bool pointer_index_remove(PointerIndex* index, void* key) {
+
+    if (key == NULL || index->capacity == 0) { return false; }
+
+    size_t mask = index->capacity - 1;
+    size_t position = pointer_index_position(index, key);
+
+    while (index->entries[position].key != key) {
+
+        if (index->entries[position].key == NULL) {
+
+            // Reached an empty entry, the key is not present
+            return false;
+
+        }
+
+        position = (position + 1) & mask;
+
+    }
+
+    /*
+     * Shift the following entries of the probe sequence backwards
+     * into the emptied entry, unless doing so would move an entry
+     * in front of the position its key hashes to.
+     */
+    size_t empty = position;
+    size_t current = (position + 1) & mask;
+
+    while (index->entries[current].key != NULL) {
+
+        size_t home = pointer_index_position(index, index->entries[current].key);
+
+        // The distance from the home position to the current and empty entry
+        size_t current_distance = (current - home) & mask;
+        size_t empty_distance = (empty - home) & mask;
+
+        if (empty_distance < current_distance) {
+
+            index->entries[empty] = index->entries[current];
+            empty = current;
+
+        }
+
+        current = (current + 1) & mask;
+
+    }
+
+    index->entries[empty].key = NULL;
+    index->entries[empty].value = NULL;
+    index->size--;
+
+    return true;
+
+}
@@ -0,0 +1,93 @@
+/**
+ * @file pointer_index.h
+ * @brief Open addressing hash table mapping pointers to pointers.
+ *
+ * @details
+ * The PointerIndex does not allocate any memory by itself. The
+ * memory for its entries is handed over during initialization,
+ * which lets the Allocator place the entries within its reserved
+ * pool. Collisions are resolved through linear probing and
+ * removals shift the following entries backwards, so no
+ * tombstones are left behind.
+ *
+ * To keep the probe sequences short, the PointerIndex refuses
+ * insertions beyond three quarters of its capacity.
+ */
+
+#ifndef POINTER_INDEX_H
+#define POINTER_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+
+    // The key of the entry, NULL marks an empty entry
+    void* key;
+
+    void* value;
+
+} PointerIndexEntry;
+
+typedef struct {
+
+    PointerIndexEntry* entries;
+
+    // The number of entries, always a power of two
+    size_t capacity;
+
+    // The number of occupied entries
+    size_t size;
+
+} PointerIndex;
+
+/*
+* @brief Initialize an empty PointerIndex.
+*
+* @param1 The PointerIndex to initialize.
+* @param2 Memory for 'capacity' entries.
+* @param3 The number of entries, has to be a power of two.
+*/
+void pointer_index_init(PointerIndex* index, PointerIndexEntry* entries, size_t capacity);
+
+/*
+* @brief Initialize an empty PointerIndex like pointer_index_init(),
+* over entries known to be zeroed, e.g. freshly mapped pages. The
+* entries are not written, thus such pages stay uncommitted.
+*
+* @param1 The PointerIndex to initialize.
+* @param2 Zeroed memory for 'capacity' entries.
+* @param3 The number of entries, has to be a power of two.
+*/
+void pointer_index_init_zeroed(PointerIndex* index, PointerIndexEntry* entries, size_t capacity);
+
+/*
+* @brief Insert a key with its value. If the key is already
+* present, its value is overwritten.
+*
+* @param1 The PointerIndex.
+* @param2 The key, must not be NULL.
+* @param3 The value.
+* @return Whether the key was inserted, false if the index is full.
+*/
+bool pointer_index_insert(PointerIndex* index, void* key, void* value);
+
+/*
+* @brief Retrieve the value of a key.
+*
+* @param1 The PointerIndex.
+* @param2 The key.
+* @return The value, or NULL if the key is not present.
+*/
+void* pointer_index_lookup(PointerIndex* index, void* key);
+
+/*
+* @brief Remove a key along with its value.
+*
+* @param1 The PointerIndex.
+* @param2 The key.
+* @return Whether the key was present.
+*/
+bool pointer_index_remove(PointerIndex* index, void* key);
+
+#endif // POINTER_INDEX_H
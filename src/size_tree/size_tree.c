@@ -0,0 +1,309 @@
+#include "size_tree.h"
+#include "../other_modules/memory_data.h"
+
+/*
+ * @brief Retrieve the height of a subtree, an empty subtree
+ * has height 0.
+ */
+size_t tree_height_of(Node* node) {
+
+    if (!node) { return 0; }
+
+    return ((MemoryData*) node->data)->tree_height;
+
+}
+
+/*
+ * @brief Recompute the height of a Node from its children.
+ */
+void tree_update_height(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    size_t left_height = tree_height_of(data->left_free);
+    size_t right_height = tree_height_of(data->right_free);
+
+    data->tree_height = 1 + (left_height > right_height ? left_height : right_height);
+
+}
+
+/*
+ * @brief Compare the keys of two Nodes, being the memory block
+ * size and then the start of the memory block.
+ *
+ * @return Negative, zero or positive if 'a' is smaller, equal
+ * or larger than 'b' respectively.
+ */
+int tree_compare(Node* a, Node* b) {
+
+    MemoryData* a_data = (MemoryData*) a->data;
+    MemoryData* b_data = (MemoryData*) b->data;
+
+    if (a_data->block_size != b_data->block_size) {
+
+        return a_data->block_size < b_data->block_size ? -1 : 1;
+
+    }
+
+    if (a_data->memory_start != b_data->memory_start) {
+
+        return a_data->memory_start < b_data->memory_start ? -1 : 1;
+
+    }
+
+    return 0;
+
+}
+
+/*
+ * @brief Rotate a subtree to the right, lifting its left child.
+ *
+ * @return The new root of the subtree.
+ */
+Node* tree_rotate_right(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    Node* pivot = data->left_free;
+    MemoryData* pivot_data = (MemoryData*) pivot->data;
+
+    data->left_free = pivot_data->right_free;
+    pivot_data->right_free = node;
+
+    tree_update_height(node);
+    tree_update_height(pivot);
+
+    return pivot;
+
+}
+
+/*
+ * @brief Rotate a subtree to the left, lifting its right child.
+ *
+ * @return The new root of the subtree.
+ */
+Node* tree_rotate_left(Node* node) {
+
+    MemoryData* data = (MemoryData*) node->data;
+    Node* pivot = data->right_free;
+    MemoryData* pivot_data = (MemoryData*) pivot->data;
+
+    data->right_free = pivot_data->left_free;
+    pivot_data->left_free = node;
+
+    tree_update_height(node);
+    tree_update_height(pivot);
+
+    return pivot;
+
+}
+
+/*
+ * @brief Restore the AVL property of a subtree whose children
+ * differ in height by at most two.
+ *
+ * @return The new root of the subtree.
+ */
+Node* tree_rebalance(Node* node) {
+
+    tree_update_height(node);
+
+    MemoryData* data = (MemoryData*) node->data;
+    size_t left_height = tree_height_of(data->left_free);
+    size_t right_height = tree_height_of(data->right_free);
+
+    if (left_height > right_height + 1) {
+
+        // Left heavy, a left-right case is turned into a left-left case
+        MemoryData* left_data = (MemoryData*) data->left_free->data;
+
+        if (tree_height_of(left_data->left_free) < tree_height_of(left_data->right_free)) {
+
+            data->left_free = tree_rotate_left(data->left_free);
+
+        }
+
+        return tree_rotate_right(node);
+
+    }
+
+    if (right_height > left_height + 1) {
+
+        // Right heavy, a right-left case is turned into a right-right case
+        MemoryData* right_data = (MemoryData*) data->right_free->data;
+
+        if (tree_height_of(right_data->right_free) < tree_height_of(right_data->left_free)) {
+
+            data->right_free = tree_rotate_right(data->right_free);
+
+        }
+
+        return tree_rotate_left(node);
+
+    }
+
+    return node;
+
+}
+
+Node* size_tree_insert(Node* root, Node* node) {
+
+    if (!root) {
+
+        // Found the position of the Node, it becomes a leaf
+        MemoryData* data = (MemoryData*) node->data;
+        data->left_free = NULL;
+        data->right_free = NULL;
+        data->tree_height = 1;
+
+        return node;
+
+    }
+
+    MemoryData* root_data = (MemoryData*) root->data;
+
+    if (tree_compare(node, root) < 0) {
+
+        root_data->left_free = size_tree_insert(root_data->left_free, node);
+
+    } else {
+
+        root_data->right_free = size_tree_insert(root_data->right_free, node);
+
+    }
+
+    return tree_rebalance(root);
+
+}
+
+/*
+ * @brief Detach the Node with the smallest key from a subtree.
+ *
+ * @param1 The root of the subtree.
+ * @param2 Output for the detached Node.
+ * @return The new root of the subtree.
+ */
+Node* tree_remove_min(Node* root, Node** min) {
+
+    MemoryData* root_data = (MemoryData*) root->data;
+
+    if (!root_data->left_free) {
+
+        *min = root;
+
+        return root_data->right_free;
+
+    }
+
+    root_data->left_free = tree_remove_min(root_data->left_free, min);
+
+    return tree_rebalance(root);
+
+}
+
+Node* size_tree_remove(Node* root, Node* node) {
+
+    if (!root) {
+
+        // The Node is not in the tree
+        return NULL;
+
+    }
+
+    MemoryData* root_data = (MemoryData*) root->data;
+    int comparison = tree_compare(node, root);
+
+    if (comparison < 0) {
+
+        root_data->left_free = size_tree_remove(root_data->left_free, node);
+
+        return tree_rebalance(root);
+
+    }
+
+    if (comparison > 0) {
+
+        root_data->right_free = size_tree_remove(root_data->right_free, node);
+
+        return tree_rebalance(root);
+
+    }
+
+    // The Node has been found, detach it from its children
+    Node* left = root_data->left_free;
+    Node* right = root_data->right_free;
+    root_data->left_free = NULL;
+    root_data->right_free = NULL;
+
+    if (!right) { return left; }
+
+    /*
+     * Take the successor of the Node from the right subtree
+     * and let it take the place of the removed Node.
+     */
+    Node* successor = NULL;
+    right = tree_remove_min(right, &successor);
+
+    MemoryData* successor_data = (MemoryData*) successor->data;
+    successor_data->left_free = left;
+    successor_data->right_free = right;
+
+    return tree_rebalance(successor);
+
+}
+
+Node* size_tree_best_fit(Node* root, size_t size, bool address_ordered) {
+
+    Node* best_node = NULL;
+    Node* node = root;
+
+    while (node) {
+
+        MemoryData* data = (MemoryData*) node->data;
+
+        if (data->block_size < size) {
+
+            // Too small, larger memory blocks are to the right
+            node = data->right_free;
+            continue;
+
+        }
+
+        // The Node fits, look for a tighter fit to the left
+        best_node = node;
+
+        if (data->block_size == size && !address_ordered) {
+
+            // Cannot get a tighter fit than an exact fit
+            break;
+
+        }
+
+        node = data->left_free;
+
+    }
+
+    return best_node;
+
+}
+
+Node** size_tree_find_link(Node** root, Node* node) {
+
+    Node** link = root;
+
+    while (*link) {
+
+        int comparison = tree_compare(node, *link);
+
+        if (comparison == 0) {
+
+            return *link == node ? link : NULL;
+
+        }
+
+        MemoryData* data = (MemoryData*) (*link)->data;
+        link = comparison < 0 ? &data->left_free : &data->right_free;
+
+    }
+
+    return NULL;
+
+}
@@ -0,0 +1,66 @@
+/**
+ * @file size_tree.h
+ * @brief Size ordered balanced tree of metadata Nodes.
+ *
+ * @details
+ * An AVL tree holding metadata Nodes with free memory blocks,
+ * ordered by the memory block size and then by the start of the
+ * memory block. As the start of a memory block is unique, so is
+ * the key of each Node in the tree. The tree is intrusive, meaning
+ * that the links and height are stored within the MemoryData of
+ * each Node, thus no memory has to be allocated for the tree.
+ *
+ * The functions take the root of a (sub)tree and return the new
+ * root, as rebalancing may rotate a different Node to the top.
+ */
+
+#ifndef SIZE_TREE_H
+#define SIZE_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../linked_list/node.h"
+
+/*
+* @brief Insert a Node into the tree.
+*
+* @param1 The root of the tree.
+* @param2 The Node to be inserted.
+* @return The new root of the tree.
+*/
+Node* size_tree_insert(Node* root, Node* node);
+
+/*
+* @brief Remove a Node from the tree.
+*
+* @param1 The root of the tree.
+* @param2 The Node to be removed.
+* @return The new root of the tree.
+*/
+Node* size_tree_remove(Node* root, Node* node);
+
+/*
+* @brief Search for the Node with the smallest memory block that
+* fits 'size'. When 'address_ordered' is set, the Node with the
+* lowest memory address is chosen among the equally sized memory
+* blocks. Otherwise, the search stops at the first exact fit.
+*
+* @param1 The root of the tree.
+* @param2 The size requirement for the memory block.
+* @param3 Whether to break ties by memory address.
+* @return The best fitting Node or NULL if none fits.
+*/
+Node* size_tree_best_fit(Node* root, size_t size, bool address_ordered);
+
+/*
+* @brief Retrieve the link referencing the Node within the tree.
+* This is either one of the child links of its parent, or the
+* root link itself. Used to update the tree when a Node moves.
+*
+* @param1 Pointer to the root link of the tree.
+* @param2 The Node to look for.
+* @return Pointer to the link referencing the Node or NULL.
+*/
+Node** size_tree_find_link(Node** root, Node* node);
+
+#endif // SIZE_TREE_H
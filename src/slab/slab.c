@@ -0,0 +1,254 @@
+#include "slab.h"
+
+/*
+ * @brief Retrieve the page map entry of the page containing 'ptr'.
+ *
+ * @param1 The SlabCache.
+ * @param2 A pointer within the pool.
+ * @return The index of the page.
+ */
+size_t slab_page(SlabCache* cache, void* ptr) {
+
+    return (size_t) ((char*) ptr - cache->pool_start) / SLAB_SIZE;
+
+}
+
+/*
+ * @brief Push a slab on the list of slabs with vacant objects.
+ *
+ * @param1 The SlabCache.
+ * @param2 The slab.
+ */
+void slab_push(SlabCache* cache, Slab* slab) {
+
+    size_t index = slab_class(slab->object_size);
+    Slab* head = cache->partial[index];
+
+    slab->prev = NULL;
+    slab->next = head;
+
+    if (head) {
+
+        head->prev = slab;
+
+    }
+
+    cache->partial[index] = slab;
+
+}
+
+/*
+ * @brief Unlink a slab from the list of slabs with vacant objects.
+ *
+ * @param1 The SlabCache.
+ * @param2 The slab.
+ */
+void slab_unlink(SlabCache* cache, Slab* slab) {
+
+    if (slab->prev) {
+
+        slab->prev->next = slab->next;
+
+    } else {
+
+        cache->partial[slab_class(slab->object_size)] = slab->next;
+
+    }
+
+    if (slab->next) {
+
+        slab->next->prev = slab->prev;
+
+    }
+
+    slab->next = NULL;
+    slab->prev = NULL;
+
+}
+
+void slab_cache_init(SlabCache* cache, Slab** page_map, size_t page_count, char* pool_start) {
+
+    for (size_t i = 0; i < SLAB_CLASS_COUNT; i++) {
+
+        cache->partial[i] = NULL;
+
+    }
+
+    cache->page_map = page_map;
+    cache->page_count = page_count;
+    cache->pool_start = pool_start;
+
+    for (size_t i = 0; i < page_count; i++) {
+
+        page_map[i] = NULL;
+
+    }
+
+}
+
+size_t slab_class(size_t size) {
+
+    size_t index = 0;
+
+    while (index < SLAB_CLASS_COUNT && ((size_t) 8 << index) < size) {
+
+        index++;
+
+    }
+
+    return index;
+
+}
+
+void* slab_malloc(SlabCache* cache, size_t size) {
+
+    Slab* slab = cache->partial[slab_class(size)];
+
+    if (slab == NULL) {
+
+        // Every slab of the size class is full
+        return NULL;
+
+    }
+
+    // Occupy the first vacant object
+    size_t index = 0;
+
+    for (size_t i = 0; i < SLAB_BITMAP_WORDS; i++) {
+
+        if (~slab->bitmap[i]) {
+
+            index = i * 64 + __builtin_ctzll(~slab->bitmap[i]);
+            break;
+
+        }
+
+    }
+
+    slab->bitmap[index / 64] |= (uint64_t) 1 << (index % 64);
+    slab->used_count++;
+
+    if (slab->used_count == slab->capacity) {
+
+        // Full slabs are left out of the list until an object is freed
+        slab_unlink(cache, slab);
+
+    }
+
+    return slab->objects + index * slab->object_size;
+
+}
+
+void slab_create(SlabCache* cache, char* memory, size_t size) {
+
+    Slab* slab = (Slab*) memory;
+
+    slab->object_size = (size_t) 8 << slab_class(size);
+    slab->objects = memory + ((sizeof(Slab) + 7) & ~(size_t) 7);
+    slab->capacity = (memory + SLAB_SIZE - slab->objects) / slab->object_size;
+    slab->used_count = 0;
+
+    // Mark the bits beyond the capacity as occupied, so they are never handed out
+    for (size_t i = 0; i < SLAB_BITMAP_WORDS; i++) {
+
+        size_t first = i * 64;
+
+        if (first >= slab->capacity) {
+
+            slab->bitmap[i] = ~(uint64_t) 0;
+
+        } else if (slab->capacity - first < 64) {
+
+            slab->bitmap[i] = ~(uint64_t) 0 << (slab->capacity - first);
+
+        } else {
+
+            slab->bitmap[i] = 0;
+
+        }
+
+    }
+
+    cache->page_map[slab_page(cache, memory)] = slab;
+    slab_push(cache, slab);
+
+}
+
+Slab* slab_lookup(SlabCache* cache, void* ptr) {
+
+    char* location = (char*) ptr;
+
+    if (location < cache->pool_start) { return NULL; }
+
+    size_t page = slab_page(cache, location);
+
+    if (page >= cache->page_count) { return NULL; }
+
+    // The slab starts either within the page of 'ptr' or the page before
+    Slab* slab = cache->page_map[page];
+
+    if (slab && (char*) slab <= location && location < (char*) slab + SLAB_SIZE) {
+
+        return slab;
+
+    }
+
+    slab = page > 0 ? cache->page_map[page - 1] : NULL;
+
+    if (slab && (char*) slab <= location && location < (char*) slab + SLAB_SIZE) {
+
+        return slab;
+
+    }
+
+    return NULL;
+
+}
+
+bool slab_occupied(Slab* slab, void* ptr) {
+
+    char* location = (char*) ptr;
+
+    if (location < slab->objects || (size_t) (location - slab->objects) % slab->object_size != 0) {
+
+        // Not the start of an object
+        return false;
+
+    }
+
+    size_t index = (location - slab->objects) / slab->object_size;
+
+    return index < slab->capacity && (slab->bitmap[index / 64] & ((uint64_t) 1 << (index % 64)));
+
+}
+
+bool slab_free(SlabCache* cache, Slab* slab, void* ptr) {
+
+    if (!slab_occupied(slab, ptr)) { return false; }
+
+    size_t index = ((char*) ptr - slab->objects) / slab->object_size;
+    uint64_t bit = (uint64_t) 1 << (index % 64);
+
+    slab->bitmap[index / 64] &= ~bit;
+    slab->used_count--;
+
+    if (slab->used_count + 1 == slab->capacity) {
+
+        // The slab was full, it has vacant objects again
+        slab_push(cache, slab);
+
+    }
+
+    // Keep a single empty slab of the size class around to avoid thrashing
+    if (slab->used_count == 0 && (slab->prev || slab->next)) {
+
+        slab_unlink(cache, slab);
+        cache->page_map[slab_page(cache, slab)] = NULL;
+
+        return true;
+
+    }
+
+    return false;
+
+}
@@ -0,0 +1,141 @@
+/**
+ * @file slab.h
+ * @brief Slabs of small fixed-size objects.
+ *
+ * @details
+ * A Slab is a memory block of SLAB_SIZE bytes split into objects of
+ * a single size class, with a bitmap telling which objects are
+ * occupied. The SlabCache keeps the slabs with vacant objects in one
+ * list for each size class, such that allocating an object only has
+ * to find a cleared bit, while freeing an object clears its bit.
+ * Thus, the objects carry no metadata of their own.
+ *
+ * The SlabCache does not acquire the memory of its slabs by itself.
+ * The memory is handed over through slab_create() and handed back
+ * once slab_free() reports that a slab became empty. To find the
+ * slab of an object, every slab is recorded in a page map at the
+ * page of the pool it starts in. As a slab spans at least a page,
+ * no two slabs start within the same page and an object lies either
+ * in the slab of its own page or in the slab of the page before.
+ */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The size of a slab and of the pages of the page map
+#define SLAB_SIZE 4096
+
+// Size classes of 8, 16, 32, 64, 128 and 256 bytes
+#define SLAB_CLASS_COUNT 6
+#define SLAB_MAX_OBJECT_SIZE 256
+
+// Enough bitmap words for a slab of the smallest objects
+#define SLAB_BITMAP_WORDS 8
+
+typedef struct Slab {
+
+    // Neighbours in the list of slabs with vacant objects
+    struct Slab* next;
+    struct Slab* prev;
+
+    size_t object_size;
+
+    // The number of objects fitting the slab
+    size_t capacity;
+
+    // The number of occupied objects
+    size_t used_count;
+
+    // Start of the first object
+    char* objects;
+
+    // Bit 'i' is set when object 'i' is occupied
+    uint64_t bitmap[SLAB_BITMAP_WORDS];
+
+} Slab;
+
+typedef struct {
+
+    // Heads of the lists of slabs with vacant objects, one for each size class
+    Slab* partial[SLAB_CLASS_COUNT];
+
+    // Entry 'q' references the slab starting within page 'q' of the pool
+    Slab** page_map;
+    size_t page_count;
+
+    char* pool_start;
+
+} SlabCache;
+
+/*
+* @brief Initialize an empty SlabCache.
+*
+* @param1 The SlabCache to initialize.
+* @param2 Memory for 'page_count' page map entries.
+* @param3 The number of pages of the pool.
+* @param4 The start of the pool the slabs are placed in.
+*/
+void slab_cache_init(SlabCache* cache, Slab** page_map, size_t page_count, char* pool_start);
+
+/*
+* @brief Determine the size class of an object.
+*
+* @param The size of the object.
+* @return The size class, SLAB_CLASS_COUNT if the object is too large.
+*/
+size_t slab_class(size_t size);
+
+/*
+* @brief Allocate an object from a slab with vacant objects.
+*
+* @param1 The SlabCache.
+* @param2 The size of the object, at most SLAB_MAX_OBJECT_SIZE.
+* @return A pointer to the object, or NULL if a new slab is needed.
+*/
+void* slab_malloc(SlabCache* cache, size_t size);
+
+/*
+* @brief Turn SLAB_SIZE bytes of the pool into an empty slab for
+* the size class of 'size'.
+*
+* @param1 The SlabCache.
+* @param2 The memory of the slab, within the pool.
+* @param3 The size of the objects, at most SLAB_MAX_OBJECT_SIZE.
+*/
+void slab_create(SlabCache* cache, char* memory, size_t size);
+
+/*
+* @brief Retrieve the slab containing 'ptr' through the page map.
+*
+* @param1 The SlabCache.
+* @param2 The pointer.
+* @return The slab, or NULL if 'ptr' does not lie within a slab.
+*/
+Slab* slab_lookup(SlabCache* cache, void* ptr);
+
+/*
+* @brief Check whether 'ptr' is an occupied object of a slab.
+*
+* @param1 The slab containing 'ptr'.
+* @param2 The pointer.
+* @return Whether 'ptr' starts an occupied object.
+*/
+bool slab_occupied(Slab* slab, void* ptr);
+
+/*
+* @brief Free the object at 'ptr'. A slab that becomes empty is
+* removed from the SlabCache, unless it is the only slab of its
+* size class with vacant objects.
+*
+* @param1 The SlabCache.
+* @param2 The slab containing 'ptr'.
+* @param3 The object.
+* @return Whether the slab was removed, its memory may then be released.
+*/
+bool slab_free(SlabCache* cache, Slab* slab, void* ptr);
+
+#endif // SLAB_H
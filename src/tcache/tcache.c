@@ -0,0 +1,61 @@
+#include "tcache.h"
+
+void tcache_init(Tcache* cache) {
+
+    for (size_t i = 0; i < TCACHE_CLASS_COUNT; i++) {
+
+        cache->stacks[i] = NULL;
+        cache->counts[i] = 0;
+
+    }
+
+}
+
+size_t tcache_class(size_t size) {
+
+    size_t size_class = 0;
+
+    while (size_class < TCACHE_CLASS_COUNT && tcache_class_size(size_class) < size) {
+
+        size_class++;
+
+    }
+
+    return size_class;
+
+}
+
+size_t tcache_class_size(size_t size_class) {
+
+    return ((size_t) 16 << size_class) - TCACHE_HEADER_SIZE;
+
+}
+
+TcacheHeader* tcache_header(void* ptr) {
+
+    return (TcacheHeader*) ((char*) ptr - TCACHE_HEADER_SIZE);
+
+}
+
+size_t tcache_push(Tcache* cache, size_t size_class, void* ptr) {
+
+    // The memory block is not in use, its first word links the stack
+    *(void**) ptr = cache->stacks[size_class];
+    cache->stacks[size_class] = ptr;
+
+    return ++cache->counts[size_class];
+
+}
+
+void* tcache_pop(Tcache* cache, size_t size_class) {
+
+    void* ptr = cache->stacks[size_class];
+
+    if (ptr == NULL) { return NULL; }
+
+    cache->stacks[size_class] = *(void**) ptr;
+    cache->counts[size_class]--;
+
+    return ptr;
+
+}
@@ -0,0 +1,117 @@
+/**
+ * @file tcache.h
+ * @brief Stacks of cached memory blocks for small size classes.
+ *
+ * @details
+ * A Tcache keeps one stack of memory blocks for each size class,
+ * linked through the first word of the memory blocks themselves.
+ * It is meant to be owned by a single thread, thus it takes no
+ * lock of its own. Pushing and popping a memory block only touches
+ * the head of a stack.
+ *
+ * Every memory block handed out while caching is enabled starts
+ * with a TcacheHeader, holding the size class of the memory block
+ * and whether it is in use or cached. The size classes are chosen
+ * such that a memory block of a size class, header included, is a
+ * power of two in size, exactly fitting the size classes of slabs.
+ *
+ * Like the SlabCache, the Tcache does not acquire memory by itself.
+ * Memory blocks are pushed once freed and popped to be reused,
+ * handing them back to their Allocator is up to the caller.
+ */
+
+#ifndef TCACHE_H
+#define TCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The size of the TcacheHeader preceding every memory block
+#define TCACHE_HEADER_SIZE 8
+
+// Size classes of 8, 24, 56, 120 and 248 bytes
+#define TCACHE_CLASS_COUNT 5
+#define TCACHE_MAX_SIZE 248
+
+// A stack holding more memory blocks than this is flushed
+#define TCACHE_HIGH_WATER 32
+
+// The number of memory blocks handed back by a single flush
+#define TCACHE_FLUSH_BATCH 16
+
+// Values of the state of a TcacheHeader
+#define TCACHE_IN_USE 0x7CAC4E01u
+#define TCACHE_CACHED 0x7CAC4E02u
+
+typedef struct {
+
+    // The size class, TCACHE_CLASS_COUNT for memory blocks that are never cached
+    uint32_t size_class;
+
+    // TCACHE_IN_USE or TCACHE_CACHED
+    uint32_t state;
+
+} TcacheHeader;
+
+typedef struct {
+
+    // Tops of the stacks of cached memory blocks, one for each size class
+    void* stacks[TCACHE_CLASS_COUNT];
+
+    // The number of memory blocks in each stack
+    size_t counts[TCACHE_CLASS_COUNT];
+
+} Tcache;
+
+/*
+* @brief Initialize a Tcache with empty stacks.
+*
+* @param The Tcache to initialize.
+*/
+void tcache_init(Tcache* cache);
+
+/*
+* @brief Determine the size class of a memory block.
+*
+* @param The requested size, header excluded.
+* @return The size class, TCACHE_CLASS_COUNT if the size is too large.
+*/
+size_t tcache_class(size_t size);
+
+/*
+* @brief Retrieve the usable size of the memory blocks of a size class.
+*
+* @param The size class.
+* @return The size of the memory blocks, header excluded.
+*/
+size_t tcache_class_size(size_t size_class);
+
+/*
+* @brief Retrieve the header of a memory block.
+*
+* @param A pointer handed out while caching is enabled.
+* @return The TcacheHeader preceding 'ptr'.
+*/
+TcacheHeader* tcache_header(void* ptr);
+
+/*
+* @brief Push a memory block on the stack of its size class.
+*
+* @param1 The Tcache.
+* @param2 The size class of the memory block.
+* @param3 The memory block, its header marked as cached.
+* @return The number of memory blocks in the stack afterwards.
+*/
+size_t tcache_push(Tcache* cache, size_t size_class, void* ptr);
+
+/*
+* @brief Pop a memory block from the stack of a size class.
+*
+* @param1 The Tcache.
+* @param2 The size class.
+* @return The memory block, or NULL if the stack is empty.
+*/
+void* tcache_pop(Tcache* cache, size_t size_class);
+
+#endif // TCACHE_H
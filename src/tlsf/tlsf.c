@@ -0,0 +1,512 @@
+#include <stdint.h>
+#include <string.h>
+#include "tlsf.h"
+
+// The header preceding every memory block, the free list links are not part of it
+#define TLSF_HEADER_SIZE offsetof(TlsfBlock, next_free)
+
+// The smallest memory block, fitting the free list links
+#define TLSF_MIN_SIZE (sizeof(TlsfBlock) - TLSF_HEADER_SIZE)
+
+#define TLSF_MAX_SIZE ((size_t) 1 << TLSF_FL_INDEX_MAX)
+
+// The lowest bit of the size of a free memory block is set
+#define TLSF_FREE_BIT ((size_t) 1)
+
+/*
+ * @brief Retrieve the size of a memory block without its flags.
+ *
+ * @param The memory block.
+ * @return The size following the header.
+ */
+size_t tlsf_block_size(TlsfBlock* block) {
+
+    return block->size & ~TLSF_FREE_BIT;
+
+}
+
+/*
+ * @brief Check whether a memory block is free.
+ *
+ * @param The memory block.
+ * @return Whether the memory block is in a free list.
+ */
+bool tlsf_block_is_free(TlsfBlock* block) {
+
+    return block->size & TLSF_FREE_BIT;
+
+}
+
+/*
+ * @brief Retrieve the memory block header physically following 'block'.
+ *
+ * @param The memory block.
+ * @return The next memory block, the sentinel for the last memory block.
+ */
+TlsfBlock* tlsf_next_physical(TlsfBlock* block) {
+
+    return (TlsfBlock*) ((char*) block + TLSF_HEADER_SIZE + tlsf_block_size(block));
+
+}
+
+/*
+ * @brief Determine the free list holding memory blocks of 'size' bytes.
+ *
+ * @param1 The size of the memory block.
+ * @param2 Output for the first level index.
+ * @param3 Output for the second level index.
+ */
+void tlsf_mapping(size_t size, size_t* fl, size_t* sl) {
+
+    if (size < ((size_t) 1 << TLSF_FL_INDEX_SHIFT)) {
+
+        // Small memory blocks are split linearly in steps of 8 bytes
+        *fl = 0;
+        *sl = size >> 3;
+
+    } else {
+
+        size_t log2 = (sizeof(size_t) * 8 - 1) - __builtin_clzl(size);
+        *sl = (size >> (log2 - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        *fl = log2 - TLSF_FL_INDEX_SHIFT + 1;
+
+    }
+
+}
+
+/*
+ * @brief Push a memory block on its free list and mark it free.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The memory block.
+ */
+void tlsf_insert_block(TlsfControl* control, TlsfBlock* block) {
+
+    size_t fl, sl;
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+
+    TlsfBlock* head = control->blocks[fl][sl];
+
+    block->prev_free = NULL;
+    block->next_free = head;
+
+    if (head) {
+
+        head->prev_free = block;
+
+    }
+
+    control->blocks[fl][sl] = block;
+    control->fl_bitmap |= (size_t) 1 << fl;
+    control->sl_bitmap[fl] |= 1U << sl;
+
+    block->size |= TLSF_FREE_BIT;
+
+}
+
+/*
+ * @brief Unlink a memory block from its free list and mark it in use.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The memory block.
+ */
+void tlsf_remove_block(TlsfControl* control, TlsfBlock* block) {
+
+    size_t fl, sl;
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+
+    if (block->prev_free) {
+
+        block->prev_free->next_free = block->next_free;
+
+    } else {
+
+        control->blocks[fl][sl] = block->next_free;
+
+    }
+
+    if (block->next_free) {
+
+        block->next_free->prev_free = block->prev_free;
+
+    }
+
+    // Clear the bits of free lists that became empty
+    if (control->blocks[fl][sl] == NULL) {
+
+        control->sl_bitmap[fl] &= ~(1U << sl);
+
+        if (control->sl_bitmap[fl] == 0) {
+
+            control->fl_bitmap &= ~((size_t) 1 << fl);
+
+        }
+
+    }
+
+    block->size &= ~TLSF_FREE_BIT;
+
+}
+
+/*
+ * @brief Find a free memory block of at least 'size' bytes. The
+ * size is rounded up to the next free list boundary, such that
+ * every memory block of the found free list fits.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The required size.
+ * @return The head of a suitable free list, or NULL if there is none.
+ */
+TlsfBlock* tlsf_find_suitable(TlsfControl* control, size_t size) {
+
+    if (size >= ((size_t) 1 << TLSF_FL_INDEX_SHIFT)) {
+
+        size_t log2 = (sizeof(size_t) * 8 - 1) - __builtin_clzl(size);
+        size += ((size_t) 1 << (log2 - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+
+    }
+
+    size_t fl, sl;
+    tlsf_mapping(size, &fl, &sl);
+
+    if (fl >= TLSF_FL_INDEX_COUNT) { return NULL; }
+
+    // Look for a non-empty free list within the same first level
+    unsigned int sl_map = control->sl_bitmap[fl] & (~0U << sl);
+
+    if (!sl_map) {
+
+        // Fall back on the smallest non-empty larger first level
+        size_t fl_map = control->fl_bitmap & (~(size_t) 0 << (fl + 1));
+
+        if (!fl_map) { return NULL; }
+
+        fl = __builtin_ctzl(fl_map);
+        sl_map = control->sl_bitmap[fl];
+
+    }
+
+    sl = __builtin_ctz(sl_map);
+
+    return control->blocks[fl][sl];
+
+}
+
+/*
+ * @brief Split the end of a memory block off into a new free
+ * memory block, if the remainder is large enough to be one.
+ * The remainder is not inserted into any free list.
+ *
+ * @param1 The memory block to shrink.
+ * @param2 The size to shrink the memory block to.
+ * @return The remainder, or NULL if the memory block was not split.
+ */
+TlsfBlock* tlsf_split_block(TlsfBlock* block, size_t size) {
+
+    size_t block_size = tlsf_block_size(block);
+
+    if (block_size < size + TLSF_HEADER_SIZE + TLSF_MIN_SIZE) { return NULL; }
+
+    TlsfBlock* remainder = (TlsfBlock*) ((char*) block + TLSF_HEADER_SIZE + size);
+    remainder->size = block_size - size - TLSF_HEADER_SIZE;
+    remainder->prev_physical = block;
+    tlsf_next_physical(remainder)->prev_physical = remainder;
+
+    block->size = size | (block->size & TLSF_FREE_BIT);
+
+    return remainder;
+
+}
+
+/*
+ * @brief Merge the memory block physically following 'block' into
+ * 'block' if it is free, removing it from its free list.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The memory block, not part of any free list.
+ */
+void tlsf_merge_next(TlsfControl* control, TlsfBlock* block) {
+
+    TlsfBlock* next = tlsf_next_physical(block);
+
+    if (!tlsf_block_is_free(next)) { return; }
+
+    tlsf_remove_block(control, next);
+
+    block->size += TLSF_HEADER_SIZE + tlsf_block_size(next);
+    tlsf_next_physical(block)->prev_physical = block;
+
+}
+
+/*
+ * @brief Merge 'block' into the memory block physically preceding
+ * it if that one is free, removing it from its free list.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The memory block, not part of any free list.
+ * @return The merged memory block.
+ */
+TlsfBlock* tlsf_merge_prev(TlsfControl* control, TlsfBlock* block) {
+
+    TlsfBlock* prev = block->prev_physical;
+
+    if (!prev || !tlsf_block_is_free(prev)) { return block; }
+
+    tlsf_remove_block(control, prev);
+
+    prev->size += TLSF_HEADER_SIZE + tlsf_block_size(block);
+    tlsf_next_physical(prev)->prev_physical = prev;
+
+    return prev;
+
+}
+
+/*
+ * @brief Retrieve the header of the memory block in use at 'ptr'.
+ * The header is verified against the headers of both physically
+ * adjacent memory blocks, which rejects most pointers that were
+ * never handed out without searching for them.
+ *
+ * @param1 The TlsfControl.
+ * @param2 The pointer to verify.
+ * @return The memory block, or NULL if 'ptr' is not in use.
+ */
+TlsfBlock* tlsf_used_block(TlsfControl* control, void* ptr) {
+
+    char* payload = (char*) ptr;
+
+    if (payload < control->pool_start + TLSF_HEADER_SIZE
+        || payload >= control->pool_end - TLSF_HEADER_SIZE
+        || (uintptr_t) payload % 8 != 0) {
+
+        return NULL;
+
+    }
+
+    TlsfBlock* block = (TlsfBlock*) (payload - TLSF_HEADER_SIZE);
+
+    if (tlsf_block_is_free(block)
+        || tlsf_block_size(block) > (size_t) (control->pool_end - TLSF_HEADER_SIZE - payload)) {
+
+        return NULL;
+
+    }
+
+    // The next memory block has to reference this one
+    if (tlsf_next_physical(block)->prev_physical != block) { return NULL; }
+
+    TlsfBlock* prev = block->prev_physical;
+
+    if (prev == NULL) {
+
+        // Only the first memory block has no predecessor
+        return (char*) block == control->pool_start ? block : NULL;
+
+    }
+
+    if ((char*) prev < control->pool_start
+        || prev >= block
+        || (uintptr_t) prev % 8 != 0
+        || tlsf_next_physical(prev) != block) {
+
+        return NULL;
+
+    }
+
+    return block;
+
+}
+
+/*
+ * @brief Realign a requested size to a factor of 8 and to
+ * at least the smallest memory block.
+ *
+ * @param The requested size.
+ * @return The size of the memory block to hand out.
+ */
+size_t tlsf_adjust_size(size_t size) {
+
+    size = (size + 7) & ~(size_t) 7;
+
+    return size < TLSF_MIN_SIZE ? TLSF_MIN_SIZE : size;
+
+}
+
+bool tlsf_init(TlsfControl* control, char* pool_start, size_t pool_size) {
+
+    pool_size &= ~(size_t) 7;
+
+    // The pool holds one memory block and the sentinel header ending it
+    if (pool_size < 2 * TLSF_HEADER_SIZE + TLSF_MIN_SIZE
+        || pool_size - 2 * TLSF_HEADER_SIZE >= TLSF_MAX_SIZE) {
+
+        return false;
+
+    }
+
+    control->fl_bitmap = 0;
+
+    for (size_t i = 0; i < TLSF_FL_INDEX_COUNT; i++) {
+
+        control->sl_bitmap[i] = 0;
+
+        for (size_t j = 0; j < TLSF_SL_INDEX_COUNT; j++) {
+
+            control->blocks[i][j] = NULL;
+
+        }
+
+    }
+
+    control->pool_start = pool_start;
+    control->pool_end = pool_start + pool_size;
+
+    TlsfBlock* block = (TlsfBlock*) pool_start;
+    block->prev_physical = NULL;
+    block->size = pool_size - 2 * TLSF_HEADER_SIZE;
+
+    /*
+     * The sentinel is a memory block of size 0 that is always
+     * in use, so merging never looks beyond the pool.
+     */
+    TlsfBlock* sentinel = tlsf_next_physical(block);
+    sentinel->prev_physical = block;
+    sentinel->size = 0;
+
+    tlsf_insert_block(control, block);
+
+    return true;
+
+}
+
+void* tlsf_malloc(TlsfControl* control, size_t size) {
+
+    if (size >= TLSF_MAX_SIZE) { return NULL; }
+
+    size = tlsf_adjust_size(size);
+
+    TlsfBlock* block = tlsf_find_suitable(control, size);
+
+    if (block == NULL) {
+
+        // No free memory block is large enough
+        return NULL;
+
+    }
+
+    tlsf_remove_block(control, block);
+
+    /*
+     * The physical neighbours of a free memory block are in use,
+     * so the remainder does not need to be merged with them.
+     */
+    TlsfBlock* remainder = tlsf_split_block(block, size);
+
+    if (remainder) {
+
+        tlsf_insert_block(control, remainder);
+
+    }
+
+    return (char*) block + TLSF_HEADER_SIZE;
+
+}
+
+bool tlsf_free(TlsfControl* control, void* ptr) {
+
+    TlsfBlock* block = tlsf_used_block(control, ptr);
+
+    if (block == NULL) {
+
+        // Not a memory block in use, ignore it
+        return false;
+
+    }
+
+    tlsf_merge_next(control, block);
+    block = tlsf_merge_prev(control, block);
+
+    tlsf_insert_block(control, block);
+
+    return true;
+
+}
+
+void* tlsf_realloc(TlsfControl* control, void* ptr, size_t size) {
+
+    TlsfBlock* block = tlsf_used_block(control, ptr);
+
+    if (block == NULL || size >= TLSF_MAX_SIZE) { return NULL; }
+
+    // Reallocating to 0 bytes is the same as freeing the memory block
+    if (size == 0) { tlsf_free(control, ptr); return NULL; }
+
+    size = tlsf_adjust_size(size);
+
+    size_t block_size = tlsf_block_size(block);
+    TlsfBlock* next = tlsf_next_physical(block);
+
+    // Grow into the next memory block if it is free and large enough
+    if (block_size < size
+        && tlsf_block_is_free(next)
+        && block_size + TLSF_HEADER_SIZE + tlsf_block_size(next) >= size) {
+
+        tlsf_merge_next(control, block);
+        block_size = tlsf_block_size(block);
+
+    }
+
+    if (block_size >= size) {
+
+        // Give back the unneeded end of the memory block
+        TlsfBlock* remainder = tlsf_split_block(block, size);
+
+        if (remainder) {
+
+            tlsf_merge_next(control, remainder);
+            tlsf_insert_block(control, remainder);
+
+        }
+
+        return ptr;
+
+    }
+
+    // Move the contents to a new memory block
+    void* new_ptr = tlsf_malloc(control, size);
+
+    if (new_ptr == NULL) { return NULL; }
+
+    memcpy(new_ptr, ptr, block_size);
+    tlsf_free(control, ptr);
+
+    return new_ptr;
+
+}
+
+size_t tlsf_usable_size(TlsfControl* control, void* ptr) {
+
+    TlsfBlock* block = tlsf_used_block(control, ptr);
+
+    return block ? tlsf_block_size(block) : 0;
+
+}
+
+void tlsf_for_each_free(TlsfControl* control, void (*visit)(char* start, char* end, void* context), void* context) {
+
+    for (size_t i = 0; i < TLSF_FL_INDEX_COUNT; i++) {
+
+        for (size_t j = 0; j < TLSF_SL_INDEX_COUNT; j++) {
+
+            for (TlsfBlock* block = control->blocks[i][j]; block; block = block->next_free) {
+
+                // The links of the free list stay, the header of the next memory block follows
+                visit((char*) block + sizeof(TlsfBlock), (char*) tlsf_next_physical(block), context);
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,148 @@
+/**
+ * @file tlsf.h
+ * @brief Two-level segregated fit (TLSF) memory pool.
+ *
+ * @details
+ * A TlsfControl manages a single contiguous memory pool in
+ * which every memory block is preceded by an inline TlsfBlock
+ * header. The free memory blocks are kept in segregated free
+ * lists indexed by two levels. The first level splits the
+ * block sizes into powers of two, while the second level
+ * splits every power of two linearly into TLSF_SL_INDEX_COUNT
+ * ranges. A bitmap for each level tells which free lists are
+ * non-empty, such that a fitting free list is found with two
+ * find-first-set instructions.
+ *
+ * Free memory blocks are merged with their physically adjacent
+ * free memory blocks immediately, which is done in constant time
+ * through the header of the next memory block and the reference
+ * to the previous memory block held in every header. Thus, both
+ * tlsf_malloc() and tlsf_free() run in constant time without
+ * ever scanning a list.
+ *
+ * Like the PointerIndex, the TlsfControl does not allocate any
+ * memory by itself, both the TlsfControl and the pool are handed
+ * over during initialization.
+ */
+
+#ifndef TLSF_H
+#define TLSF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// The number of second level free lists for each first level
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+
+/*
+ * Memory blocks smaller than 2^TLSF_FL_INDEX_SHIFT bytes share
+ * the first first level, split linearly in steps of 8 bytes.
+ */
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + 3)
+
+// Memory blocks are smaller than 2^TLSF_FL_INDEX_MAX bytes
+#define TLSF_FL_INDEX_MAX 40
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+
+typedef struct TlsfBlock {
+
+    // The physically preceding memory block, NULL for the first one
+    struct TlsfBlock* prev_physical;
+
+    /*
+     * The size of the memory block following the header. Sizes
+     * are multiples of 8, so the lowest bit marks a free block.
+     */
+    size_t size;
+
+    /*
+     * The links of the free list. They overlap the start of the
+     * memory block, thus they are only valid for free blocks.
+     */
+    struct TlsfBlock* next_free;
+    struct TlsfBlock* prev_free;
+
+} TlsfBlock;
+
+typedef struct {
+
+    // Bit 'i' is set when any free list of first level 'i' is non-empty
+    size_t fl_bitmap;
+
+    // Bit 'j' of entry 'i' is set when free list [i][j] is non-empty
+    unsigned int sl_bitmap[TLSF_FL_INDEX_COUNT];
+
+    // Heads of the free lists
+    TlsfBlock* blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+    // The memory pool being managed
+    char* pool_start;
+    char* pool_end;
+
+} TlsfControl;
+
+/*
+* @brief Initialize a TlsfControl managing the memory pool
+* at 'pool_start' as a single free memory block.
+*
+* @param1 The TlsfControl to initialize.
+* @param2 The start of the memory pool, aligned to 8 bytes.
+* @param3 The size of the memory pool.
+* @return Whether the pool is large enough to be managed.
+*/
+bool tlsf_init(TlsfControl* control, char* pool_start, size_t pool_size);
+
+/*
+* @brief Allocate a memory block of at least 'size' bytes.
+*
+* @param1 The TlsfControl.
+* @param2 The requested size.
+* @return A pointer to the memory block, or NULL if no free
+* memory block is large enough.
+*/
+void* tlsf_malloc(TlsfControl* control, size_t size);
+
+/*
+* @brief Free the memory block at 'ptr' and merge it with its
+* physically adjacent free memory blocks.
+*
+* @param1 The TlsfControl.
+* @param2 A pointer returned by tlsf_malloc() or tlsf_realloc().
+* @return Whether 'ptr' was an allocated memory block.
+*/
+bool tlsf_free(TlsfControl* control, void* ptr);
+
+/*
+* @brief Resize the memory block at 'ptr'. The memory block is
+* resized in place when possible, otherwise its contents are moved
+* to a new memory block.
+*
+* @param1 The TlsfControl.
+* @param2 A pointer returned by tlsf_malloc() or tlsf_realloc().
+* @param3 The new size, a size of 0 frees the memory block.
+* @return A pointer to the resized memory block, or NULL if it
+* could not be resized, leaving the memory block untouched.
+*/
+void* tlsf_realloc(TlsfControl* control, void* ptr, size_t size);
+
+/*
+* @brief Retrieve the number of bytes usable at 'ptr'.
+*
+* @param1 The TlsfControl.
+* @param2 A pointer returned by tlsf_malloc() or tlsf_realloc().
+* @return The size of the memory block, or 0 if it is not in use.
+*/
+size_t tlsf_usable_size(TlsfControl* control, void* ptr);
+
+/*
+* @brief Visit every free memory block with the range of its memory
+* not holding any header or link, which may be discarded.
+*
+* @param1 The TlsfControl.
+* @param2 Called with the start and end of the range and 'context'.
+* @param3 Handed over to every call of 'visit'.
+*/
+void tlsf_for_each_free(TlsfControl* control, void (*visit)(char* start, char* end, void* context), void* context);
+
+#endif // TLSF_H
@@ -3,8 +3,13 @@
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 #include "../src/allocator/allocator.h"
+#include "../src/arena/arena.h"
 #include "../src/linked_list/linked_list_iterator.h"
 #include "../src/linked_list/merge_sort_linked_list.h"
 
@@ -117,7 +122,7 @@ void creation_test() {
 
     printf("\n%s\n", "STARTING TEST: creation_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -134,7 +139,7 @@ void malloc_test() {
 
     printf("\n%s\n", "STARTING TEST: malloc_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -159,7 +164,7 @@ void free_test() {
 
     printf("\n%s\n", "STARTING TEST: free_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -231,7 +236,7 @@ void cleanse_reserved_pool_test() {
 
     printf("\n%s\n", "STARTING TEST: cleanse_reserved_pool_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -287,7 +292,7 @@ void cleanse_user_pool_test() {
 
     printf("\n%s\n", "STARTING TEST: cleanse_user_pool_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -344,7 +349,7 @@ void realloc_test() {
 
     printf("\n%s\n", "STARTING TEST: realloc_test");
 
-    Allocator* alloc = create_allocator(800);
+    Allocator* alloc = create_allocator(2048);
     set_allocator(alloc);
 
     print_allocator_stats(alloc);
@@ -449,6 +454,2257 @@ void heap_full_test() {
 
 }
 
+/*
+ * Count the Nodes of a size ordered tree, verifying that each Node
+ * is free and that the tree is ordered and balanced. Returns
+ * (size_t) -1 on an invalid tree.
+ */
+size_t count_size_tree(Node* node, size_t min_size) {
+
+    if (!node) { return 0; }
+
+    MemoryData* data = node->data;
+
+    if (!data->is_free || !data->in_use || data->block_size < min_size) {
+
+        return (size_t) -1;
+
+    }
+
+    size_t left_count = count_size_tree(data->left_free, min_size);
+    size_t right_count = count_size_tree(data->right_free, data->block_size);
+
+    if (left_count == (size_t) -1 || right_count == (size_t) -1) {
+
+        return (size_t) -1;
+
+    }
+
+    // The left subtree must not hold larger memory blocks
+    if (data->left_free && ((MemoryData*) data->left_free->data)->block_size > data->block_size) {
+
+        return (size_t) -1;
+
+    }
+
+    size_t left_height = data->left_free ? ((MemoryData*) data->left_free->data)->tree_height : 0;
+    size_t right_height = data->right_free ? ((MemoryData*) data->right_free->data)->tree_height : 0;
+
+    if (left_height > right_height + 1 || right_height > left_height + 1) {
+
+        return (size_t) -1;
+
+    }
+
+    return 1 + left_count + right_count;
+
+}
+
+/*
+ * A custom placement policy plugged in through the AllocatorConfig:
+ * an unordered list of free Nodes searched first fit, kept in the
+ * 'placement_state' of each Allocator rather than in the Allocator.
+ */
+typedef struct {
+
+    Node* head;
+    size_t count;
+
+} ListPolicyState;
+
+void list_policy_insert(Allocator* alloc, Node* node) {
+
+    ListPolicyState* state = alloc->placement_state;
+    MemoryData* data = node->data;
+
+    data->prev_free = NULL;
+    data->next_free = state->head;
+
+    if (state->head) { ((MemoryData*) state->head->data)->prev_free = node; }
+
+    state->head = node;
+    state->count++;
+
+}
+
+void list_policy_remove(Allocator* alloc, Node* node) {
+
+    ListPolicyState* state = alloc->placement_state;
+    MemoryData* data = node->data;
+
+    if (data->prev_free) {
+
+        ((MemoryData*) data->prev_free->data)->next_free = data->next_free;
+
+    } else {
+
+        state->head = data->next_free;
+
+    }
+
+    if (data->next_free) { ((MemoryData*) data->next_free->data)->prev_free = data->prev_free; }
+
+    data->prev_free = NULL;
+    data->next_free = NULL;
+    state->count--;
+
+}
+
+Node* list_policy_search(Allocator* alloc, size_t size) {
+
+    ListPolicyState* state = alloc->placement_state;
+
+    for (Node* node = state->head; node; node = ((MemoryData*) node->data)->next_free) {
+
+        if (size <= ((MemoryData*) node->data)->block_size) { return node; }
+
+    }
+
+    return NULL;
+
+}
+
+void list_policy_relocate(Allocator* alloc, Node* node, Node* moved_node) {
+
+    ListPolicyState* state = alloc->placement_state;
+    MemoryData* moved_data = moved_node->data;
+
+    if (moved_data->prev_free) {
+
+        ((MemoryData*) moved_data->prev_free->data)->next_free = moved_node;
+
+    } else if (state->head == node) {
+
+        state->head = moved_node;
+
+    }
+
+    if (moved_data->next_free) { ((MemoryData*) moved_data->next_free->data)->prev_free = moved_node; }
+
+}
+
+const PlacementOps list_policy_ops =
+    { list_policy_insert, list_policy_remove, list_policy_search, list_policy_relocate };
+
+/*
+ * Verify that the memory blocks of the LinkedList cover the whole
+ * user pool without gaps, that their boundary tags are intact and that the free memory block index of
+ * the placement policy holds exactly the free memory blocks.
+ */
+bool check_heap_consistency(Allocator* alloc) {
+
+    LinkedList* list = alloc->list;
+
+    // The LinkedList has to be sorted by memory address
+    char* expected_start = alloc->heap_start;
+    size_t free_count = 0;
+    size_t used_count = 0;
+    Node* prev_node = NULL;
+
+    LinkedListIterator iter;
+    iter.current = list->head;
+
+    while (has_next(&iter)) {
+
+        Node* node = next(&iter);
+        MemoryData* data = node->data;
+
+        // The previous Node reference has to mirror the next Node reference
+        if (node->prev != prev_node) {
+
+            printf("Invalid previous Node reference at %p\n", (void*) data->memory_start);
+            return false;
+
+        }
+
+        prev_node = node;
+
+        if (data->memory_start != expected_start || !data->in_use) {
+
+            printf("Inconsistent memory block at %p\n", (void*) data->memory_start);
+            return false;
+
+        }
+
+        // Both boundary tags have to reference the Node
+        Node* header = *(Node**) data->memory_start;
+        Node* footer = *(Node**) (data->memory_start + data->block_size - TAG_SIZE);
+
+        if (header != node || footer != node) {
+
+            printf("Invalid boundary tags at %p\n", (void*) data->memory_start);
+            return false;
+
+        }
+
+        if (data->is_free) { free_count++; } else { used_count++; }
+
+        expected_start = data->memory_start + data->block_size;
+
+    }
+
+    if (expected_start != alloc->reserved_pool_border) {
+
+        printf("User pool ends at %p, not at the reserved pool border\n", (void*) expected_start);
+        return false;
+
+    }
+
+    if (list->tail && ((MemoryData*) list->tail->data)->memory_start + ((MemoryData*) list->tail->data)->block_size != expected_start) {
+
+        printf("The tail Node is not the last memory block\n");
+        return false;
+
+    }
+
+    // Every memory block in use is either indexed or counted as unindexed
+    if (alloc->pointer_index.size + alloc->unindexed_count != used_count) {
+
+        printf("The pointer index holds %zu Nodes, expected %zu\n", alloc->pointer_index.size, used_count);
+        return false;
+
+    }
+
+    // The vacant slots have to lie within the reserved pool and not be in use
+    for (Node* slot = alloc->vacant_slots; slot; slot = slot->next) {
+
+        MemoryData* data = (MemoryData*) ((char*) slot + align_size(sizeof(Node)));
+
+        if ((char*) slot < alloc->reserved_pool_border || data->in_use) {
+
+            printf("Invalid vacant slot at %p\n", (void*) slot);
+            return false;
+
+        }
+
+    }
+
+    if (alloc->placement.insert == list_policy_insert) {
+
+        ListPolicyState* state = alloc->placement_state;
+        size_t list_count = 0;
+
+        for (Node* node = state->head; node; node = ((MemoryData*) node->data)->next_free) {
+
+            if (!((MemoryData*) node->data)->is_free) {
+
+                printf("Invalid Node in the list of the custom placement policy\n");
+                return false;
+
+            }
+
+            list_count++;
+
+        }
+
+        if (list_count != free_count || state->count != free_count) {
+
+            printf("The custom placement policy holds %zu Nodes, expected %zu\n", list_count, free_count);
+            return false;
+
+        }
+
+        return true;
+
+    }
+
+    if (alloc->placement_policy == NEXT_FIT) {
+
+        // Go around the ring once, starting at the rover
+        size_t ring_count = 0;
+        Node* node = alloc->rover;
+
+        while (node && (ring_count == 0 || node != alloc->rover)) {
+
+            MemoryData* data = node->data;
+
+            if (!data->is_free || ((MemoryData*) data->next_free->data)->prev_free != node) {
+
+                printf("Invalid Node in the next-fit ring\n");
+                return false;
+
+            }
+
+            ring_count++;
+            node = data->next_free;
+
+        }
+
+        if (ring_count != free_count) {
+
+            printf("The next-fit ring holds %zu Nodes, expected %zu\n", ring_count, free_count);
+            return false;
+
+        }
+
+        return true;
+
+    }
+
+    if (alloc->placement_policy != SEGREGATED_FIT) {
+
+        size_t tree_count = count_size_tree(alloc->size_tree, 0);
+
+        if (tree_count != free_count) {
+
+            printf("The size tree holds %zu Nodes, expected %zu\n", tree_count, free_count);
+            return false;
+
+        }
+
+        return true;
+
+    }
+
+    size_t bin_count = 0;
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+
+        Node* node = alloc->bins[i];
+
+        while (node) {
+
+            MemoryData* data = node->data;
+
+            if (!data->is_free || !data->in_use || size_class(data->block_size) != i) {
+
+                printf("Invalid Node in bin %zu\n", i);
+                return false;
+
+            }
+
+            bin_count++;
+            node = data->next_free;
+
+        }
+
+    }
+
+    if (bin_count != free_count) {
+
+        printf("The bins hold %zu Nodes, expected %zu\n", bin_count, free_count);
+        return false;
+
+    }
+
+    return true;
+
+}
+
+/*
+ * Walks the memory blocks of a TLSF pool through their headers and
+ * compares the free memory blocks found with the free lists and bitmaps.
+ */
+bool check_tlsf_consistency(TlsfControl* control) {
+
+    size_t header_size = offsetof(TlsfBlock, next_free);
+    size_t free_count = 0;
+    bool prev_free = false;
+
+    TlsfBlock* prev = NULL;
+    TlsfBlock* block = (TlsfBlock*) control->pool_start;
+
+    while ((char*) block < control->pool_end - header_size) {
+
+        bool is_free = block->size & 1;
+
+        if (block->prev_physical != prev || (is_free && prev_free)) {
+
+            printf("Inconsistent TLSF memory block at %p\n", (void*) block);
+            return false;
+
+        }
+
+        if (is_free) { free_count++; }
+
+        prev_free = is_free;
+        prev = block;
+        block = (TlsfBlock*) ((char*) block + header_size + (block->size & ~(size_t) 1));
+
+    }
+
+    // The pool has to end in the sentinel
+    if ((char*) block != control->pool_end - header_size || block->size != 0 || block->prev_physical != prev) {
+
+        printf("The TLSF pool does not end in the sentinel\n");
+        return false;
+
+    }
+
+    size_t listed_count = 0;
+
+    for (size_t i = 0; i < TLSF_FL_INDEX_COUNT; i++) {
+
+        for (size_t j = 0; j < TLSF_SL_INDEX_COUNT; j++) {
+
+            bool bit = control->sl_bitmap[i] & (1U << j);
+
+            if (bit != (control->blocks[i][j] != NULL)) {
+
+                printf("Second level bitmap out of sync at [%zu][%zu]\n", i, j);
+                return false;
+
+            }
+
+            for (TlsfBlock* node = control->blocks[i][j]; node; node = node->next_free) {
+
+                listed_count++;
+
+            }
+
+        }
+
+        if (((control->fl_bitmap >> i) & 1) != (control->sl_bitmap[i] != 0)) {
+
+            printf("First level bitmap out of sync at %zu\n", i);
+            return false;
+
+        }
+
+    }
+
+    if (listed_count != free_count) {
+
+        printf("%zu free memory blocks, %zu in the free lists\n", free_count, listed_count);
+        return false;
+
+    }
+
+    return true;
+
+}
+
+/*
+ * Walks the memory blocks of a buddy pool through their headers and
+ * compares the free memory blocks found with the free lists. Free
+ * memory blocks must not have a free buddy of the same order left.
+ */
+bool check_buddy_consistency(BuddyControl* control) {
+
+    size_t free_count = 0;
+    size_t offset = 0;
+
+    while (offset < control->pool_size) {
+
+        BuddyBlock* block = (BuddyBlock*) (control->pool_start + offset);
+        size_t size = BUDDY_MIN_BLOCK_SIZE << block->order;
+
+        if (block->order >= BUDDY_ORDER_COUNT || offset % size != 0 || offset + size > control->pool_size) {
+
+            printf("Inconsistent buddy memory block at %p\n", (void*) block);
+            return false;
+
+        }
+
+        if (block->is_free) {
+
+            free_count++;
+
+            size_t buddy_offset = offset ^ size;
+            BuddyBlock* buddy = (BuddyBlock*) (control->pool_start + buddy_offset);
+
+            if (buddy_offset + size <= control->pool_size && buddy->is_free && buddy->order == block->order) {
+
+                printf("Unmerged buddies at %p\n", (void*) block);
+                return false;
+
+            }
+
+        }
+
+        offset += size;
+
+    }
+
+    size_t listed_count = 0;
+
+    for (size_t i = 0; i < BUDDY_ORDER_COUNT; i++) {
+
+        if (((control->order_map >> i) & 1) != (control->free_lists[i] != NULL)) {
+
+            printf("Order bitmap out of sync at %zu\n", i);
+            return false;
+
+        }
+
+        for (BuddyBlock* node = control->free_lists[i]; node; node = node->next_free) {
+
+            if (node->order != i || !node->is_free) {
+
+                printf("Memory block of order %u in free list %zu\n", node->order, i);
+                return false;
+
+            }
+
+            listed_count++;
+
+        }
+
+    }
+
+    if (listed_count != free_count) {
+
+        printf("%zu free memory blocks, %zu in the free lists\n", free_count, listed_count);
+        return false;
+
+    }
+
+    return true;
+
+}
+
+/*
+ * Perform random allocations, reallocations and frees while
+ * verifying the content of the memory blocks and the consistency
+ * of the Allocator.
+ */
+void stress_test(AllocatorConfig config) {
+
+    printf("\n%s%d%s%d%s%d\n", "STARTING TEST: stress_test with engine ", config.engine,
+        ", placement policy ", config.placement_policy, " and slabs ", config.use_slabs);
+
+    Allocator* alloc = create_allocator_with_config(64 * 1024, config);
+    set_allocator(alloc);
+
+    #define STRESS_SLOTS 64
+    unsigned char* ptrs[STRESS_SLOTS] = { NULL };
+    size_t sizes[STRESS_SLOTS] = { 0 };
+    bool passed = true;
+
+    for (int round = 0; round < 20000 && passed; round++) {
+
+        int slot = rand() % STRESS_SLOTS;
+
+        if (ptrs[slot]) {
+
+            // Verify the content before giving up the memory block
+            for (size_t i = 0; i < sizes[slot]; i++) {
+
+                if (ptrs[slot][i] != (unsigned char) (slot + i)) {
+
+                    printf("Corrupted memory block in slot %d\n", slot);
+                    passed = false;
+                    break;
+
+                }
+
+            }
+
+            if (rand() % 4 == 0) {
+
+                size_t size = 1 + rand() % 512;
+                unsigned char* ptr = allocator_realloc(ptrs[slot], size);
+
+                if (ptr) {
+
+                    for (size_t i = sizes[slot]; i < size; i++) {
+
+                        ptr[i] = (unsigned char) (slot + i);
+
+                    }
+
+                    ptrs[slot] = ptr;
+                    sizes[slot] = size;
+
+                }
+
+            } else {
+
+                allocator_free(ptrs[slot]);
+                ptrs[slot] = NULL;
+
+            }
+
+        } else {
+
+            size_t size = 1 + rand() % 512;
+            unsigned char* ptr = allocator_malloc(size);
+
+            if (ptr) {
+
+                for (size_t i = 0; i < size; i++) {
+
+                    ptr[i] = (unsigned char) (slot + i);
+
+                }
+
+                ptrs[slot] = ptr;
+                sizes[slot] = size;
+
+            }
+
+        }
+
+        if (round % 97 == 0) {
+
+            cleanse_user_pool();
+            cleanse_reserved_pool();
+
+        }
+
+        bool consistent = config.engine == TLSF_ENGINE
+            ? check_tlsf_consistency(alloc->tlsf)
+            : config.engine == BUDDY_ENGINE
+            ? check_buddy_consistency(alloc->buddy)
+            : check_heap_consistency(alloc);
+
+        if (!consistent) {
+
+            passed = false;
+
+        }
+
+    }
+
+    printf("%s\n", passed ? "stress_test PASSED" : "stress_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void best_fit_test() {
+
+    printf("\n%s\n", "STARTING TEST: best_fit_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.placement_policy = ADDRESS_ORDERED_BEST_FIT;
+
+    Allocator* alloc = create_allocator_with_config(4096, config);
+    set_allocator(alloc);
+
+    // Leave free memory blocks of 64 and 24 bytes between used ones
+    void* large = allocator_malloc(64);
+    void* barrier_1 = allocator_malloc(8);
+    void* small = allocator_malloc(24);
+    void* barrier_2 = allocator_malloc(8);
+
+    allocator_free(large);
+    allocator_free(small);
+
+    // The tightest fit is the 24 byte memory block
+    void* ptr = allocator_malloc(16);
+
+    printf("%s\n", ptr == small ? "best_fit_test PASSED" : "best_fit_test FAILED");
+
+    allocator_free(ptr);
+    allocator_free(barrier_1);
+    allocator_free(barrier_2);
+
+    destroy_allocator();
+
+}
+
+void invalid_free_test() {
+
+    printf("\n%s\n", "STARTING TEST: invalid_free_test");
+
+    Allocator* alloc = create_allocator(4096);
+    set_allocator(alloc);
+
+    char* ptr = allocator_malloc(64);
+    char* other = allocator_malloc(64);
+    int on_stack = 0;
+
+    // None of these pointers have been handed out by the Allocator
+    allocator_free(ptr + 8);
+    allocator_free(&on_stack);
+    allocator_free(alloc->reserved_pool_border);
+
+    // Freeing twice is ignored
+    allocator_free(ptr);
+    allocator_free(ptr);
+
+    bool passed = check_heap_consistency(alloc) && retrieve_node(other) != NULL;
+    printf("%s\n", passed ? "invalid_free_test PASSED" : "invalid_free_test FAILED");
+
+    allocator_free(other);
+
+    destroy_allocator();
+
+}
+
+void pointer_index_overflow_test() {
+
+    printf("\n%s\n", "STARTING TEST: pointer_index_overflow_test");
+
+    Allocator* alloc = create_allocator(8192);
+    set_allocator(alloc);
+
+    // More memory blocks than the pointer index can hold
+    #define OVERFLOW_COUNT 40
+    void* ptrs[OVERFLOW_COUNT];
+
+    for (int i = 0; i < OVERFLOW_COUNT; i++) {
+
+        ptrs[i] = allocator_malloc(16);
+
+    }
+
+    bool passed = alloc->unindexed_count > 0;
+
+    for (int i = 0; i < OVERFLOW_COUNT; i++) {
+
+        passed = passed && retrieve_node(ptrs[i]) != NULL;
+        allocator_free(ptrs[i]);
+
+    }
+
+    passed = passed && alloc->unindexed_count == 0 && alloc->pointer_index.size == 0;
+    passed = passed && check_heap_consistency(alloc);
+
+    printf("%s\n", passed ? "pointer_index_overflow_test PASSED" : "pointer_index_overflow_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void next_fit_test() {
+
+    printf("\n%s\n", "STARTING TEST: next_fit_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.placement_policy = NEXT_FIT;
+
+    Allocator* alloc = create_allocator_with_config(4096, config);
+    set_allocator(alloc);
+
+    // Leave three free memory blocks of 64 bytes between used ones
+    void* holes[3];
+    void* separators[3];
+
+    for (int i = 0; i < 3; i++) {
+
+        holes[i] = allocator_malloc(64);
+        separators[i] = allocator_malloc(8);
+
+    }
+
+    for (int i = 0; i < 3; i++) {
+
+        allocator_free(holes[i]);
+
+    }
+
+    /*
+     * The search resumes where the previous one left off instead of
+     * starting over. The rover still rests at the top memory block,
+     * then moves on through the holes in the order they were freed.
+     */
+    void* first = allocator_malloc(64);
+    void* second = allocator_malloc(64);
+
+    // A freed memory block goes behind the rover, the search does not restart at it
+    allocator_free(second);
+
+    void* third = allocator_malloc(64);
+    void* fourth = allocator_malloc(64);
+
+    // Past the last hole, the search returns to the rest of the top memory block
+    void* fifth = allocator_malloc(64);
+
+    // And wraps around to the hole freed in between
+    void* sixth = allocator_malloc(64);
+
+    bool passed = (char*) first > (char*) holes[2] && second == holes[0]
+        && third == holes[1] && fourth == holes[2]
+        && (char*) fifth > (char*) first && sixth == holes[0];
+    passed = passed && check_heap_consistency(alloc);
+
+    allocator_free(first);
+    allocator_free(third);
+    allocator_free(fourth);
+    allocator_free(fifth);
+    allocator_free(sixth);
+
+    for (int i = 0; i < 3; i++) {
+
+        allocator_free(separators[i]);
+
+    }
+
+    passed = passed && check_heap_consistency(alloc) && alloc->list->size == 1;
+
+    printf("%s\n", passed ? "next_fit_test PASSED" : "next_fit_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void custom_placement_test() {
+
+    printf("\n%s\n", "STARTING TEST: custom_placement_test");
+
+    // Every Allocator keeps an index of its own
+    ListPolicyState states[2] = { { NULL, 0 }, { NULL, 0 } };
+    Allocator* allocs[2];
+
+    AllocatorConfig config = default_allocator_config();
+    config.placement_ops = &list_policy_ops;
+
+    for (int i = 0; i < 2; i++) {
+
+        config.placement_state = &states[i];
+        allocs[i] = create_allocator_with_config(4096, config);
+
+    }
+
+    bool passed = states[0].count == 1 && states[1].count == 1;
+
+    // Leave two holes in the first Allocator and a single one in the second
+    void* ptrs[2][3];
+
+    for (int i = 0; i < 3; i++) {
+
+        ptrs[0][i] = allocator_malloc_from(allocs[0], 64);
+        ptrs[1][i] = allocator_malloc_from(allocs[1], 64);
+
+    }
+
+    allocator_free_to(allocs[0], ptrs[0][0]);
+    allocator_free_to(allocs[0], ptrs[0][1]);
+    allocator_free_to(allocs[1], ptrs[1][0]);
+
+    passed = passed && check_heap_consistency(allocs[0]) && check_heap_consistency(allocs[1]);
+
+    // The holes merged, the first Allocator reuses its own
+    void* reused = allocator_malloc_from(allocs[0], 64);
+    passed = passed && reused == ptrs[0][0] && check_heap_consistency(allocs[0]);
+
+    allocator_free_to(allocs[0], reused);
+    allocator_free_to(allocs[0], ptrs[0][2]);
+    allocator_free_to(allocs[1], ptrs[1][1]);
+    allocator_free_to(allocs[1], ptrs[1][2]);
+
+    for (int i = 0; i < 2; i++) {
+
+        passed = passed && check_heap_consistency(allocs[i]) && states[i].count == 1;
+        set_allocator(allocs[i]);
+        destroy_allocator();
+
+    }
+
+    printf("%s\n", passed ? "custom_placement_test PASSED" : "custom_placement_test FAILED");
+
+    // The stress test cleanses the pools, exercising the relocation callback
+    ListPolicyState stress_state = { NULL, 0 };
+    config.placement_state = &stress_state;
+    stress_test(config);
+
+}
+
+void tlsf_test() {
+
+    printf("\n%s\n", "STARTING TEST: tlsf_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.engine = TLSF_ENGINE;
+
+    Allocator* alloc = create_allocator_with_config(16 * 1024, config);
+    set_allocator(alloc);
+
+    char* first = allocator_malloc(100);
+    char* second = allocator_malloc(200);
+    char* third = allocator_malloc(300);
+
+    // A freed memory block is reused by a smaller allocation
+    allocator_free(second);
+    char* reused = allocator_malloc(150);
+    bool passed = reused == second;
+
+    // None of these pointers have been handed out by the Allocator
+    int on_stack = 0;
+    allocator_free(first + 8);
+    allocator_free(&on_stack);
+    allocator_free(reused);
+    allocator_free(reused);
+
+    // Growing into the free memory block that follows happens in place
+    memset(first, 7, 100);
+    char* grown = allocator_realloc(first, 250);
+    passed = passed && grown == first && grown[99] == 7;
+
+    allocator_free(grown);
+    allocator_free(third);
+
+    // Everything has been merged back into a single free memory block
+    passed = passed && check_tlsf_consistency(alloc->tlsf);
+    passed = passed && __builtin_popcountl(alloc->tlsf->fl_bitmap) == 1;
+    passed = passed && allocator_malloc(8 * 1024) != NULL;
+
+    printf("%s\n", passed ? "tlsf_test PASSED" : "tlsf_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void buddy_test() {
+
+    printf("\n%s\n", "STARTING TEST: buddy_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.engine = BUDDY_ENGINE;
+
+    Allocator* alloc = create_allocator_with_config(16 * 1024, config);
+    set_allocator(alloc);
+
+    BuddyControl* control = alloc->buddy;
+
+    /*
+     * At most one of three allocations of the same order takes a free
+     * memory block of that order, the others are split off as buddies.
+     */
+    char* first = allocator_malloc(100);
+    char* second = allocator_malloc(100);
+    char* third = allocator_malloc(100);
+    size_t first_offset = first - control->pool_start;
+    size_t second_offset = second - control->pool_start;
+    size_t third_offset = third - control->pool_start;
+    bool passed = (second_offset ^ 128) == third_offset || (first_offset ^ 128) == second_offset;
+    allocator_free(third);
+
+    // Freeing twice or pointers never handed out is ignored
+    int on_stack = 0;
+    allocator_free(first + 8);
+    allocator_free(&on_stack);
+    allocator_free(second);
+    allocator_free(second);
+
+    // Shrinking keeps the memory block in place
+    memset(first, 7, 100);
+    char* shrunk = allocator_realloc(first, 20);
+    passed = passed && shrunk == first && shrunk[19] == 7;
+
+    // Growing beyond the memory block moves the contents
+    char* grown = allocator_realloc(shrunk, 500);
+    passed = passed && grown && grown[19] == 7;
+
+    allocator_free(grown);
+
+    // Everything has been merged back into the initial memory blocks
+    passed = passed && check_buddy_consistency(control);
+
+    size_t block_count = 0;
+    for (size_t i = 0; i < BUDDY_ORDER_COUNT; i++) {
+
+        block_count += control->free_lists[i] != NULL;
+
+    }
+
+    passed = passed && block_count == (size_t) __builtin_popcountl(control->pool_size);
+
+    printf("%s\n", passed ? "buddy_test PASSED" : "buddy_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void slab_test() {
+
+    printf("\n%s\n", "STARTING TEST: slab_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_slabs = true;
+
+    Allocator* alloc = create_allocator_with_config(64 * 1024, config);
+    set_allocator(alloc);
+
+    // Small objects of one size class share a single slab
+    #define SLAB_TEST_COUNT 100
+    char* objects[SLAB_TEST_COUNT];
+
+    for (int i = 0; i < SLAB_TEST_COUNT; i++) {
+
+        objects[i] = allocator_malloc(24);
+
+    }
+
+    Slab* slab = slab_lookup(alloc->slabs, objects[0]);
+    bool passed = slab && slab->object_size == 32 && slab->used_count == SLAB_TEST_COUNT;
+    passed = passed && objects[1] - objects[0] == 32;
+    passed = passed && alloc->list->size == 2;
+
+    // Large objects bypass the slabs
+    char* large = allocator_malloc(1000);
+    passed = passed && slab_lookup(alloc->slabs, large) == NULL;
+
+    // Freeing twice or pointers never handed out is ignored
+    allocator_free(objects[0]);
+    allocator_free(objects[0]);
+    allocator_free(objects[1] + 8);
+    allocator_free(slab);
+    passed = passed && slab->used_count == SLAB_TEST_COUNT - 1;
+
+    // Objects stay in place while they fit their size class
+    memset(objects[2], 7, 24);
+    passed = passed && allocator_realloc(objects[2], 30) == objects[2];
+
+    char* moved = allocator_realloc(objects[2], 100);
+    passed = passed && moved && moved[23] == 7 && slab_lookup(alloc->slabs, moved) != slab;
+    objects[2] = moved;
+
+    for (int i = 1; i < SLAB_TEST_COUNT; i++) {
+
+        allocator_free(objects[i]);
+
+    }
+
+    allocator_free(large);
+
+    passed = passed && check_heap_consistency(alloc);
+
+    printf("%s\n", passed ? "slab_test PASSED" : "slab_test FAILED");
+
+    destroy_allocator();
+
+}
+
+typedef struct {
+
+    Allocator* alloc;
+    unsigned int seed;
+    bool passed;
+
+} ThreadTestArgs;
+
+/*
+ * Perform random allocations and frees on the Allocator of the
+ * arguments while verifying the content of the memory blocks.
+ */
+void* thread_test_worker(void* arg) {
+
+    ThreadTestArgs* args = (ThreadTestArgs*) arg;
+    set_allocator(args->alloc);
+
+    #define THREAD_SLOTS 32
+    unsigned char* ptrs[THREAD_SLOTS] = { NULL };
+    size_t sizes[THREAD_SLOTS] = { 0 };
+    unsigned char tag = (unsigned char) args->seed;
+
+    for (int round = 0; round < 20000; round++) {
+
+        int slot = rand_r(&args->seed) % THREAD_SLOTS;
+
+        if (ptrs[slot]) {
+
+            for (size_t i = 0; i < sizes[slot]; i++) {
+
+                if (ptrs[slot][i] != tag) { args->passed = false; }
+
+            }
+
+            allocator_free(ptrs[slot]);
+            ptrs[slot] = NULL;
+
+        } else {
+
+            size_t size = 1 + rand_r(&args->seed) % 300;
+            ptrs[slot] = allocator_malloc(size);
+
+            if (ptrs[slot]) {
+
+                memset(ptrs[slot], tag, size);
+                sizes[slot] = size;
+
+            }
+
+        }
+
+    }
+
+    for (int i = 0; i < THREAD_SLOTS; i++) {
+
+        allocator_free(ptrs[i]);
+
+    }
+
+    return NULL;
+
+}
+
+void thread_test() {
+
+    printf("\n%s\n", "STARTING TEST: thread_test");
+
+    Allocator* own = create_allocator(4096);
+    set_allocator(own);
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_slabs = true;
+
+    // Four threads share an Allocator, while two use one of their own
+    #define THREAD_COUNT 6
+    Allocator* shared = create_allocator_with_config(256 * 1024, config);
+    Allocator* separate[2] = { create_allocator(64 * 1024), create_allocator(64 * 1024) };
+
+    pthread_t threads[THREAD_COUNT];
+    ThreadTestArgs args[THREAD_COUNT];
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+
+        args[i].alloc = i < 4 ? shared : separate[i - 4];
+        args[i].seed = 1 + i;
+        args[i].passed = true;
+        pthread_create(&threads[i], NULL, thread_test_worker, &args[i]);
+
+    }
+
+    bool passed = true;
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+
+        pthread_join(threads[i], NULL);
+        passed = passed && args[i].passed;
+
+    }
+
+    // Only the single empty slab kept for each size class is left in use
+    passed = passed && check_heap_consistency(shared) && shared->pointer_index.size <= SLAB_CLASS_COUNT;
+    passed = passed && check_heap_consistency(separate[0]) && check_heap_consistency(separate[1]);
+
+    // The threads setting their Allocator left the one of this thread untouched
+    char* ptr = allocator_malloc(16);
+    passed = passed && ptr >= own->heap_start && ptr < own->heap_end;
+
+    printf("%s\n", passed ? "thread_test PASSED" : "thread_test FAILED");
+
+    destroy_allocator();
+
+    for (int i = 0; i < 2; i++) {
+
+        set_allocator(separate[i]);
+        destroy_allocator();
+
+    }
+
+    set_allocator(shared);
+    destroy_allocator();
+
+}
+
+void explicit_handle_test() {
+
+    printf("\n%s\n", "STARTING TEST: explicit_handle_test");
+
+    Allocator* current = create_allocator(4096);
+    set_allocator(current);
+
+    AllocatorConfig config = default_allocator_config();
+    config.engine = TLSF_ENGINE;
+
+    Allocator* first = create_allocator(8192);
+    Allocator* second = create_allocator_with_config(8192, config);
+
+    // Interleave both heaps without switching the current Allocator
+    char* a = allocator_malloc_from(first, 100);
+    char* b = allocator_malloc_from(second, 100);
+    bool passed = a && b && a >= first->heap_start && a < first->heap_end
+        && b >= second->heap_start && b < second->heap_end;
+
+    memset(a, 3, 100);
+    a = allocator_realloc_in(first, a, 400);
+    passed = passed && a && a[99] == 3 && a >= first->heap_start && a < first->heap_end;
+
+    // Freeing to the wrong Allocator is ignored
+    allocator_free_to(first, b);
+    passed = passed && allocator_realloc_in(second, b, 50) == b;
+
+    allocator_free_to(first, a);
+    allocator_free_to(second, b);
+    passed = passed && first->pointer_index.size == 0 && check_heap_consistency(first);
+    passed = passed && check_tlsf_consistency(second->tlsf);
+
+    // The current Allocator was never switched
+    char* ptr = allocator_malloc(16);
+    passed = passed && ptr >= current->heap_start && ptr < current->heap_end;
+
+    printf("%s\n", passed ? "explicit_handle_test PASSED" : "explicit_handle_test FAILED");
+
+    destroy_allocator();
+
+    set_allocator(first);
+    destroy_allocator();
+
+    set_allocator(second);
+    destroy_allocator();
+
+}
+
+void thread_cache_test() {
+
+    printf("\n%s\n", "STARTING TEST: thread_cache_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_thread_cache = true;
+
+    Allocator* alloc = create_allocator_with_config(64 * 1024, config);
+    set_allocator(alloc);
+
+    // A freed memory block is reused by the next allocation of its size class
+    char* first = allocator_malloc(40);
+    size_t index_size = alloc->pointer_index.size;
+    allocator_free(first);
+    bool passed = allocator_malloc(50) == first && alloc->pointer_index.size == index_size;
+
+    // Freeing a cached memory block twice is ignored
+    allocator_free(first);
+    allocator_free(first);
+    char* second = allocator_malloc(50);
+    char* third = allocator_malloc(50);
+    passed = passed && second == first && third != first;
+    allocator_free(second);
+    allocator_free(third);
+
+    // Crossing the high-water mark hands a batch back to the Allocator
+    #define CACHE_TEST_COUNT (TCACHE_HIGH_WATER + 1)
+    char* ptrs[CACHE_TEST_COUNT];
+
+    for (int i = 0; i < CACHE_TEST_COUNT; i++) {
+
+        ptrs[i] = allocator_malloc(16);
+
+    }
+
+    for (int i = 0; i < CACHE_TEST_COUNT; i++) {
+
+        allocator_free(ptrs[i]);
+
+    }
+
+    ThreadCache* cache = alloc->thread_caches;
+    size_t size_class = tcache_class(16);
+    passed = passed && cache && cache->next == NULL
+        && cache->bins.counts[size_class] == CACHE_TEST_COUNT - TCACHE_FLUSH_BATCH;
+
+    // Large memory blocks bypass the cache and keep their contents when moved
+    char* large = allocator_malloc(1000);
+    memset(large, 5, 1000);
+    large = allocator_realloc(large, 3000);
+    passed = passed && large && large[999] == 5;
+    allocator_free(large);
+
+    passed = passed && check_heap_consistency(alloc);
+
+    // The caches of exiting threads are handed back
+    Allocator* shared = create_allocator_with_config(256 * 1024, config);
+    pthread_t threads[4];
+    ThreadTestArgs args[4];
+
+    for (int i = 0; i < 4; i++) {
+
+        args[i].alloc = shared;
+        args[i].seed = 11 + i;
+        args[i].passed = true;
+        pthread_create(&threads[i], NULL, thread_test_worker, &args[i]);
+
+    }
+
+    for (int i = 0; i < 4; i++) {
+
+        pthread_join(threads[i], NULL);
+        passed = passed && args[i].passed;
+
+    }
+
+    passed = passed && shared->thread_caches == NULL && shared->pointer_index.size == 0;
+    passed = passed && check_heap_consistency(shared);
+
+    // Destroying the Allocator detaches the cache of this thread
+    destroy_allocator();
+    passed = passed && cache->owner == NULL && cache->bins.counts[size_class] == 0;
+
+    set_allocator(shared);
+    destroy_allocator();
+
+    printf("%s\n", passed ? "thread_cache_test PASSED" : "thread_cache_test FAILED");
+
+}
+
+void thread_cache_alternation_test() {
+
+    printf("\n%s\n", "STARTING TEST: thread_cache_alternation_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_thread_cache = true;
+
+    Allocator* allocs[THREAD_CACHE_SLOTS + 1];
+
+    for (int i = 0; i < THREAD_CACHE_SLOTS + 1; i++) {
+
+        allocs[i] = create_allocator_with_config(16 * 1024, config);
+
+    }
+
+    // Alternating between two Allocators keeps the cache of each
+    char* first = allocator_malloc_from(allocs[0], 40);
+    char* second = allocator_malloc_from(allocs[1], 40);
+    size_t first_index = allocs[0]->pointer_index.size;
+    size_t second_index = allocs[1]->pointer_index.size;
+    bool passed = true;
+
+    for (int round = 0; round < 100 && passed; round++) {
+
+        allocator_free_to(allocs[0], first);
+        allocator_free_to(allocs[1], second);
+
+        // Memory blocks flushed to the engine would leave the pointer index
+        passed = allocs[0]->pointer_index.size == first_index
+            && allocs[1]->pointer_index.size == second_index;
+
+        passed = passed && allocator_malloc_from(allocs[0], 40) == first
+            && allocator_malloc_from(allocs[1], 40) == second;
+
+    }
+
+    ThreadCache* first_cache = allocs[0]->thread_caches;
+    passed = passed && first_cache && allocs[1]->thread_caches
+        && first_cache != allocs[1]->thread_caches;
+
+    // Once every ThreadCache is taken, the first one bound makes room
+    allocator_free_to(allocs[0], first);
+
+    for (int i = 2; i < THREAD_CACHE_SLOTS + 1; i++) {
+
+        allocator_free_to(allocs[i], allocator_malloc_from(allocs[i], 40));
+
+    }
+
+    passed = passed && allocs[0]->thread_caches == NULL && first_cache->owner == allocs[THREAD_CACHE_SLOTS];
+    passed = passed && allocs[0]->pointer_index.size == first_index - 1;
+
+    allocator_free_to(allocs[1], second);
+
+    for (int i = 0; i < THREAD_CACHE_SLOTS + 1; i++) {
+
+        passed = passed && check_heap_consistency(allocs[i]);
+        set_allocator(allocs[i]);
+        destroy_allocator();
+
+    }
+
+    printf("%s\n", passed ? "thread_cache_alternation_test PASSED" : "thread_cache_alternation_test FAILED");
+
+}
+
+typedef struct {
+
+    ArenaManager* manager;
+    unsigned seed;
+
+    // Memory blocks allocated by another thread, to be freed by this one
+    void** foreign;
+    size_t foreign_count;
+
+    // The arena of the first allocation of the thread
+    Allocator* arena;
+
+    bool passed;
+
+} ArenaTestArgs;
+
+void* arena_test_worker(void* arg) {
+
+    ArenaTestArgs* args = (ArenaTestArgs*) arg;
+
+    #define ARENA_SLOTS 32
+    unsigned char* ptrs[ARENA_SLOTS] = { NULL };
+    size_t sizes[ARENA_SLOTS] = { 0 };
+    unsigned char tag = (unsigned char) args->seed;
+
+    void* first = arena_malloc(args->manager, 64);
+    args->arena = arena_of(args->manager, first);
+    arena_free(args->manager, first);
+
+    // Free the memory blocks handed over, wherever they were allocated
+    for (size_t i = 0; i < args->foreign_count; i++) {
+
+        arena_free(args->manager, args->foreign[i]);
+
+    }
+
+    for (int round = 0; round < 20000; round++) {
+
+        int slot = rand_r(&args->seed) % ARENA_SLOTS;
+
+        if (ptrs[slot]) {
+
+            for (size_t i = 0; i < sizes[slot]; i++) {
+
+                if (ptrs[slot][i] != tag) { args->passed = false; }
+
+            }
+
+            arena_free(args->manager, ptrs[slot]);
+            ptrs[slot] = NULL;
+
+        } else {
+
+            size_t size = 1 + rand_r(&args->seed) % 300;
+            ptrs[slot] = arena_malloc(args->manager, size);
+
+            if (ptrs[slot]) {
+
+                memset(ptrs[slot], tag, size);
+                sizes[slot] = size;
+
+            }
+
+        }
+
+    }
+
+    for (int i = 0; i < ARENA_SLOTS; i++) {
+
+        arena_free(args->manager, ptrs[i]);
+
+    }
+
+    return NULL;
+
+}
+
+void arena_test() {
+
+    printf("\n%s\n", "STARTING TEST: arena_test");
+
+    #define ARENA_COUNT 3
+    #define ARENA_THREADS 6
+    #define ARENA_FOREIGN 8
+    ArenaManager* manager = create_arena_manager(ARENA_COUNT, 128 * 1024, default_allocator_config());
+    bool passed = manager && manager->arena_count == ARENA_COUNT;
+
+    // The memory blocks of this thread are freed by the workers
+    void* foreign[ARENA_THREADS][ARENA_FOREIGN];
+
+    for (int i = 0; i < ARENA_THREADS; i++) {
+
+        for (int j = 0; j < ARENA_FOREIGN; j++) {
+
+            foreign[i][j] = arena_malloc(manager, 100);
+            passed = passed && arena_of(manager, foreign[i][j]) != NULL;
+
+        }
+
+    }
+
+    pthread_t threads[ARENA_THREADS];
+    ArenaTestArgs args[ARENA_THREADS];
+
+    for (int i = 0; i < ARENA_THREADS; i++) {
+
+        args[i].manager = manager;
+        args[i].seed = 21 + i;
+        args[i].foreign = foreign[i];
+        args[i].foreign_count = ARENA_FOREIGN;
+        args[i].arena = NULL;
+        args[i].passed = true;
+        pthread_create(&threads[i], NULL, arena_test_worker, &args[i]);
+
+    }
+
+    for (int i = 0; i < ARENA_THREADS; i++) {
+
+        pthread_join(threads[i], NULL);
+        passed = passed && args[i].passed && args[i].arena != NULL;
+
+    }
+
+    // The threads were spread over more than a single arena
+    bool spread = false;
+
+    for (int i = 1; i < ARENA_THREADS; i++) {
+
+        spread = spread || args[i].arena != args[0].arena;
+
+    }
+
+    passed = passed && spread;
+
+    // Every memory block found its way back to its arena
+    for (size_t i = 0; i < ARENA_COUNT; i++) {
+
+        Allocator* arena = manager->arenas[i];
+        passed = passed && arena->pointer_index.size == 0 && check_heap_consistency(arena);
+
+    }
+
+    // Pointers outside of every arena are ignored
+    int local = 0;
+    arena_free(manager, &local);
+    passed = passed && arena_of(manager, &local) == NULL && arena_realloc(manager, &local, 8) == NULL;
+
+    printf("%s\n", passed ? "arena_test PASSED" : "arena_test FAILED");
+
+    destroy_arena_manager(manager);
+
+}
+
+void arena_huge_block_test() {
+
+    printf("\n%s\n", "STARTING TEST: arena_huge_block_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.huge_threshold = 4096;
+    ArenaManager* manager = create_arena_manager(2, 128 * 1024, config);
+
+    // A huge memory block lies outside every managed heap, yet belongs to an arena
+    char* ptr = arena_malloc(manager, 100000);
+    Allocator* arena = arena_of(manager, ptr);
+    bool passed = ptr && arena && arena->huge_blocks.size == 1;
+
+    if (ptr) { memset(ptr, 0x5a, 100000); }
+
+    char* grown = arena_realloc(manager, ptr, 200000);
+    passed = passed && grown && arena_of(manager, grown) == arena && grown[99999] == 0x5a;
+
+    arena_free(manager, grown);
+    passed = passed && arena->huge_blocks.size == 0;
+
+    printf("%s\n", passed ? "arena_huge_block_test PASSED" : "arena_huge_block_test FAILED");
+
+    destroy_arena_manager(manager);
+
+}
+
+typedef struct {
+
+    Allocator* alloc;
+    void** ptrs;
+    size_t count;
+
+} RemoteFreeArgs;
+
+void* remote_free_worker(void* arg) {
+
+    RemoteFreeArgs* args = (RemoteFreeArgs*) arg;
+
+    for (size_t i = 0; i < args->count; i++) {
+
+        allocator_free_to(args->alloc, args->ptrs[i]);
+
+    }
+
+    return NULL;
+
+}
+
+void remote_free_test() {
+
+    printf("\n%s\n", "STARTING TEST: remote_free_test");
+
+    bool passed = true;
+
+    // Once on its own and once in front of the thread caches
+    for (int variant = 0; variant < 2; variant++) {
+
+        AllocatorConfig config = default_allocator_config();
+        config.use_remote_frees = true;
+        config.use_thread_cache = variant == 1;
+
+        Allocator* alloc = create_allocator_with_config(256 * 1024, config);
+
+        #define REMOTE_THREADS 4
+        #define REMOTE_BLOCKS 64
+        void* ptrs[REMOTE_THREADS][REMOTE_BLOCKS];
+
+        for (int i = 0; i < REMOTE_THREADS; i++) {
+
+            for (int j = 0; j < REMOTE_BLOCKS; j++) {
+
+                ptrs[i][j] = allocator_malloc_from(alloc, 1 + (i * REMOTE_BLOCKS + j) % 300);
+
+            }
+
+        }
+
+        size_t index_size = alloc->pointer_index.size;
+
+        pthread_t threads[REMOTE_THREADS];
+        RemoteFreeArgs args[REMOTE_THREADS];
+
+        for (int i = 0; i < REMOTE_THREADS; i++) {
+
+            args[i].alloc = alloc;
+            args[i].ptrs = ptrs[i];
+            args[i].count = REMOTE_BLOCKS;
+            pthread_create(&threads[i], NULL, remote_free_worker, &args[i]);
+
+        }
+
+        // The owner keeps allocating while the other threads free
+        void* kept[256];
+
+        for (int i = 0; i < 256; i++) {
+
+            kept[i] = allocator_malloc_from(alloc, 1 + i);
+
+        }
+
+        for (int i = 0; i < REMOTE_THREADS; i++) {
+
+            pthread_join(threads[i], NULL);
+
+        }
+
+        for (int i = 0; i < 256; i++) {
+
+            allocator_free_to(alloc, kept[i]);
+
+        }
+
+        // The queued frees wait for the next allocation of the owner
+        void* extra = allocator_malloc_from(alloc, 100);
+        RemoteFreeArgs extra_args = { alloc, &extra, 1 };
+        pthread_create(&threads[0], NULL, remote_free_worker, &extra_args);
+        pthread_join(threads[0], NULL);
+        passed = passed && atomic_load(&alloc->remote_frees) == extra;
+
+        void* last = allocator_malloc_from(alloc, 16);
+        allocator_free_to(alloc, last);
+        passed = passed && atomic_load(&alloc->remote_frees) == NULL;
+
+        // Every queued memory block was freed, except those kept in the thread cache
+        passed = passed && check_heap_consistency(alloc);
+        passed = passed && (variant == 1 ? alloc->pointer_index.size < index_size : alloc->pointer_index.size == 0);
+
+        set_allocator(alloc);
+        destroy_allocator();
+        release_allocator();
+
+    }
+
+    printf("%s\n", passed ? "remote_free_test PASSED" : "remote_free_test FAILED");
+
+}
+
+/*
+ * Count the memory blocks held by the central bins.
+ */
+size_t central_bin_total(Allocator* alloc) {
+
+    size_t total = 0;
+
+    for (size_t i = 0; i < TCACHE_CLASS_COUNT; i++) {
+
+        total += alloc->central_bins[i].count;
+
+    }
+
+    return total;
+
+}
+
+void central_bin_test() {
+
+    printf("\n%s\n", "STARTING TEST: central_bin_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_central_bins = true;
+
+    Allocator* alloc = create_allocator_with_config(256 * 1024, config);
+    set_allocator(alloc);
+
+    // An empty central bin is refilled with a whole batch at once
+    size_t size_class = tcache_class(40);
+    char* first = allocator_malloc(40);
+    bool passed = alloc->pointer_index.size == CENTRAL_BIN_REFILL
+        && alloc->central_bins[size_class].count == CENTRAL_BIN_REFILL - 1;
+
+    // A freed memory block goes back to its central bin, freeing it twice is ignored
+    allocator_free(first);
+    allocator_free(first);
+    passed = passed && alloc->central_bins[size_class].count == CENTRAL_BIN_REFILL;
+    passed = passed && allocator_malloc(50) == first;
+    allocator_free(first);
+
+    // A central bin above its high-water mark hands a batch to the engine
+    #define CENTRAL_TEST_COUNT (CENTRAL_BIN_HIGH_WATER + 8)
+    char* ptrs[CENTRAL_TEST_COUNT];
+
+    for (int i = 0; i < CENTRAL_TEST_COUNT; i++) {
+
+        ptrs[i] = allocator_malloc(100);
+
+    }
+
+    for (int i = 0; i < CENTRAL_TEST_COUNT; i++) {
+
+        allocator_free(ptrs[i]);
+
+    }
+
+    passed = passed && alloc->central_bins[tcache_class(100)].count <= CENTRAL_BIN_HIGH_WATER;
+    passed = passed && alloc->pointer_index.size == central_bin_total(alloc);
+
+    // Threads allocating every size class at once
+    pthread_t threads[4];
+    ThreadTestArgs args[4];
+
+    for (int i = 0; i < 4; i++) {
+
+        args[i].alloc = alloc;
+        args[i].seed = 31 + i;
+        args[i].passed = true;
+        pthread_create(&threads[i], NULL, thread_test_worker, &args[i]);
+
+    }
+
+    for (int i = 0; i < 4; i++) {
+
+        pthread_join(threads[i], NULL);
+        passed = passed && args[i].passed;
+
+    }
+
+    // Every memory block still in use by the engine is held by a central bin
+    passed = passed && check_heap_consistency(alloc) && alloc->pointer_index.size == central_bin_total(alloc);
+
+    printf("%s\n", passed ? "central_bin_test PASSED" : "central_bin_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void maintenance_test() {
+
+    printf("\n%s\n", "STARTING TEST: maintenance_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_maintenance_thread = true;
+    config.maintenance_interval_ms = 1;
+
+    Allocator* alloc = create_allocator_with_config(64 * 1024, config);
+    set_allocator(alloc);
+
+    // Leave the metadata Nodes of merged memory blocks vacant in the reserved pool
+    #define MAINTENANCE_BLOCKS 200
+    char* ptrs[MAINTENANCE_BLOCKS];
+
+    pthread_mutex_lock(&alloc->lock);
+
+    for (int i = 0; i < MAINTENANCE_BLOCKS; i++) {
+
+        ptrs[i] = allocator_malloc(32);
+
+    }
+
+    for (int i = 1; i < MAINTENANCE_BLOCKS; i++) {
+
+        allocator_free(ptrs[i]);
+
+    }
+
+    // Holding the lock keeps the maintenance thread away
+    size_t fragmented_size = alloc->reserved_pool_size;
+    bool passed = alloc->vacant_slots != NULL;
+
+    pthread_mutex_unlock(&alloc->lock);
+
+    // Another thread keeps allocating while the maintenance thread compacts
+    ThreadTestArgs args = { alloc, 41, true };
+    pthread_t thread;
+    pthread_create(&thread, NULL, thread_test_worker, &args);
+    pthread_join(thread, NULL);
+    passed = passed && args.passed;
+
+    // Give the maintenance thread a few idle steps
+    struct timespec pause = { 0, 50 * 1000000 };
+    nanosleep(&pause, NULL);
+
+    pthread_mutex_lock(&alloc->lock);
+
+    passed = passed && alloc->vacant_slots == NULL && alloc->reserved_pool_size < fragmented_size;
+    passed = passed && check_heap_consistency(alloc);
+
+    pthread_mutex_unlock(&alloc->lock);
+
+    // Compacting by hand with a budget moves at most that many metadata Nodes
+    for (int i = 1; i < MAINTENANCE_BLOCKS; i++) {
+
+        ptrs[i] = allocator_malloc(32);
+
+    }
+
+    pthread_mutex_lock(&alloc->lock);
+
+    for (int i = 1; i < MAINTENANCE_BLOCKS / 2; i++) {
+
+        allocator_free(ptrs[i]);
+
+    }
+
+    allocator_free(ptrs[MAINTENANCE_BLOCKS - 1]);
+    passed = passed && compact_reserved_pool(3) == 3 && alloc->vacant_slots != NULL;
+    passed = passed && check_heap_consistency(alloc);
+
+    pthread_mutex_unlock(&alloc->lock);
+
+    printf("%s\n", passed ? "maintenance_test PASSED" : "maintenance_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void cpu_cache_test() {
+
+    printf("\n%s\n", "STARTING TEST: cpu_cache_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_cpu_cache = true;
+
+    Allocator* alloc = create_allocator_with_config(256 * 1024, config);
+    set_allocator(alloc);
+
+    bool passed = alloc->cpu_caches != NULL && alloc->cpu_cache_count > 0;
+    size_t size_class = tcache_class(16);
+
+    // A freed small memory block is cached by the CPU of the thread
+    char* ptr = allocator_malloc(16);
+    allocator_free(ptr);
+
+    size_t cached = 0;
+
+    for (size_t i = 0; i < alloc->cpu_cache_count; i++) {
+
+        cached += alloc->cpu_caches[i].bins.counts[size_class];
+
+    }
+
+    passed = passed && cached == 1;
+
+    // Many threads share as many CpuCaches as there are CPUs
+    pthread_t threads[8];
+    ThreadTestArgs args[8];
+
+    for (int i = 0; i < 8; i++) {
+
+        args[i].alloc = alloc;
+        args[i].seed = 61 + i;
+        args[i].passed = true;
+        pthread_create(&threads[i], NULL, thread_test_worker, &args[i]);
+
+    }
+
+    for (int i = 0; i < 8; i++) {
+
+        pthread_join(threads[i], NULL);
+        passed = passed && args[i].passed;
+
+    }
+
+    for (size_t i = 0; i < alloc->cpu_cache_count; i++) {
+
+        for (size_t j = 0; j < TCACHE_CLASS_COUNT; j++) {
+
+            passed = passed && alloc->cpu_caches[i].bins.counts[j] <= TCACHE_HIGH_WATER;
+
+        }
+
+    }
+
+    passed = passed && check_heap_consistency(alloc);
+
+    printf("%s\n", passed ? "cpu_cache_test PASSED" : "cpu_cache_test FAILED");
+
+    destroy_allocator();
+
+}
+
+/*
+ * Read the resident set size of the process in bytes.
+ */
+size_t resident_size() {
+
+    size_t total = 0;
+    size_t resident = 0;
+
+    FILE* statm = fopen("/proc/self/statm", "r");
+
+    if (statm == NULL) { return 0; }
+
+    if (fscanf(statm, "%zu %zu", &total, &resident) != 2) { resident = 0; }
+
+    fclose(statm);
+
+    return resident * (size_t) sysconf(_SC_PAGESIZE);
+
+}
+
+void mmap_heap_test() {
+
+    printf("\n%s\n", "STARTING TEST: mmap_heap_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.use_mmap = true;
+
+    // Reserving a large managed heap commits hardly any of it
+    size_t heap_size = (size_t) 1 << 30;
+    size_t resident_before = resident_size();
+
+    Allocator* alloc = create_allocator_with_config(heap_size, config);
+    set_allocator(alloc);
+
+    size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    bool passed = alloc != NULL && alloc->heap_source == HEAP_MMAP;
+    passed = passed && (size_t) alloc->heap_start % page_size == 0 && alloc->heap_size == heap_size;
+
+    char* ptrs[64];
+
+    for (int i = 0; passed && i < 64; i++) {
+
+        ptrs[i] = allocator_malloc(1000);
+        passed = ptrs[i] != NULL;
+
+        if (passed) { memset(ptrs[i], i, 1000); }
+
+    }
+
+    passed = passed && resident_size() - resident_before < heap_size / 16;
+    passed = passed && check_heap_consistency(alloc);
+
+    for (int i = 0; passed && i < 64; i++) {
+
+        passed = ptrs[i][999] == (char) i;
+        allocator_free(ptrs[i]);
+
+    }
+
+    passed = passed && check_heap_consistency(alloc);
+
+    printf("%s\n", passed ? "mmap_heap_test PASSED" : "mmap_heap_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void extent_test(AllocatorConfig config) {
+
+    printf("\n%s%d%s%d\n", "STARTING TEST: extent_test with engine ", config.engine,
+        " and thread cache ", config.use_thread_cache);
+
+    config.use_extents = true;
+
+    Allocator* alloc = create_allocator_with_config(16 * 1024, config);
+    set_allocator(alloc);
+
+    // Far more memory than the managed heap holds
+    #define EXTENT_BLOCKS 200
+    unsigned char* ptrs[EXTENT_BLOCKS];
+    bool passed = true;
+
+    for (int i = 0; passed && i < EXTENT_BLOCKS; i++) {
+
+        ptrs[i] = allocator_malloc(1000);
+        passed = ptrs[i] != NULL && allocator_usable_size(ptrs[i]) >= 1000;
+
+        if (passed) { memset(ptrs[i], i, 1000); }
+
+    }
+
+    // Every extent is twice as large as the one before
+    size_t extent_count = 0;
+    Allocator* last = alloc;
+
+    for (Allocator* extent = alloc->next_extent; extent; extent = extent->next_extent) {
+
+        passed = passed && extent->heap_size >= 2 * last->heap_size;
+        passed = passed && (extent->engine != LIST_ENGINE || check_heap_consistency(extent));
+        last = extent;
+        extent_count++;
+
+    }
+
+    passed = passed && extent_count > 0 && extent_of(alloc, ptrs[EXTENT_BLOCKS - 1]) == last;
+
+    // Growing a memory block of the first heap moves it into an extent
+    unsigned char* moved = allocator_realloc(ptrs[0], 20000);
+    passed = passed && moved && extent_of(alloc, moved) != alloc && moved[999] == 0;
+    ptrs[0] = moved;
+
+    for (int i = 0; passed && i < EXTENT_BLOCKS; i++) {
+
+        passed = ptrs[i][500] == (unsigned char) i;
+        allocator_free(ptrs[i]);
+
+    }
+
+    // Pointers of no extent are ignored
+    int stack_variable = 0;
+    allocator_free(&stack_variable);
+    passed = passed && allocator_usable_size(&stack_variable) == 0;
+
+    passed = passed && (alloc->engine != LIST_ENGINE || check_heap_consistency(alloc));
+
+    printf("%s\n", passed ? "extent_test PASSED" : "extent_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void trim_test(AllocatorConfig config) {
+
+    printf("\n%s%d\n", "STARTING TEST: trim_test with engine ", config.engine);
+
+    config.use_mmap = true;
+
+    Allocator* alloc = create_allocator_with_config(16 * 1024 * 1024, config);
+    set_allocator(alloc);
+
+    // A spike of memory, touched all over
+    size_t spike_size = 4 * 1024 * 1024;
+    char* kept = allocator_malloc(1000);
+    char* spike = allocator_malloc(spike_size);
+    memset(kept, 7, 1000);
+    memset(spike, 1, spike_size);
+
+    size_t resident_at_peak = resident_size();
+    allocator_free(spike);
+
+    // Without a threshold, only allocator_trim() releases the pages
+    bool passed = alloc->trim_threshold == 0 && resident_size() + spike_size / 2 > resident_at_peak;
+    passed = passed && allocator_trim() >= spike_size - 2 * (size_t) sysconf(_SC_PAGESIZE);
+    passed = passed && resident_size() + spike_size / 2 <= resident_at_peak;
+
+    // The released pages are handed out again
+    spike = allocator_malloc(spike_size);
+    passed = passed && spike && kept[999] == 7;
+
+    if (spike) {
+
+        memset(spike, 2, spike_size);
+        allocator_free(spike);
+
+    }
+
+    // With a threshold, freeing releases the pages once decayed
+    alloc->trim_threshold = 64 * 1024;
+    alloc->trim_decay_ms = 60 * 60 * 1000;
+
+    spike = allocator_malloc(spike_size);
+    passed = passed && spike;
+
+    if (spike) { allocator_free(spike); }
+
+    passed = passed && alloc->freed_since_trim >= spike_size;
+
+    alloc->trim_decay_ms = 0;
+    spike = allocator_malloc(spike_size);
+    passed = passed && spike;
+
+    if (spike) { allocator_free(spike); }
+
+    passed = passed && alloc->freed_since_trim == 0 && kept[999] == 7;
+    passed = passed && (alloc->engine != LIST_ENGINE || check_heap_consistency(alloc));
+
+    allocator_free(kept);
+
+    printf("%s\n", passed ? "trim_test PASSED" : "trim_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void huge_block_test(AllocatorConfig config) {
+
+    printf("\n%s%d%s%d\n", "STARTING TEST: huge_block_test with engine ", config.engine,
+        " and thread cache ", config.use_thread_cache);
+
+    config.huge_threshold = 64 * 1024;
+
+    Allocator* alloc = create_allocator_with_config(256 * 1024, config);
+    set_allocator(alloc);
+
+    // A huge memory block is mapped outside of the managed heap
+    size_t huge_size = 1024 * 1024;
+    char* huge = allocator_malloc(huge_size);
+    size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+
+    bool passed = huge && (huge < alloc->heap_start || huge >= alloc->heap_end);
+    passed = passed && (size_t) huge % page_size == 0 && allocator_usable_size(huge) >= huge_size;
+    passed = passed && alloc->huge_blocks.size == 1;
+
+    if (!passed) {
+
+        printf("%s\n", "huge_block_test FAILED");
+        destroy_allocator();
+        return;
+
+    }
+
+    memset(huge, 3, huge_size);
+
+    // Growing keeps the contents, shrinking below the threshold moves it into the managed heap
+    huge = allocator_realloc(huge, 2 * huge_size);
+    passed = passed && huge && huge[huge_size - 1] == 3 && alloc->huge_blocks.size == 1;
+
+    huge = allocator_realloc(huge, 100);
+    passed = passed && huge && huge >= alloc->heap_start && huge < alloc->heap_end;
+    passed = passed && huge[99] == 3 && alloc->huge_blocks.size == 0;
+
+    // Growing a memory block of the managed heap past the threshold maps it
+    huge = allocator_realloc(huge, 200 * 1024);
+    passed = passed && huge && huge[99] == 3 && alloc->huge_blocks.size == 1;
+    allocator_free(huge);
+    passed = passed && alloc->huge_blocks.size == 0;
+
+    // Enough huge memory blocks to grow the side table
+    #define HUGE_BLOCKS 300
+    char* ptrs[HUGE_BLOCKS];
+
+    for (int i = 0; i < HUGE_BLOCKS; i++) {
+
+        ptrs[i] = allocator_malloc(64 * 1024);
+        passed = passed && ptrs[i];
+
+        if (ptrs[i]) { ptrs[i][0] = (char) i; }
+
+    }
+
+    passed = passed && alloc->huge_blocks.size == HUGE_BLOCKS;
+
+    for (int i = 0; i < HUGE_BLOCKS; i++) {
+
+        passed = passed && ptrs[i] && ptrs[i][0] == (char) i;
+        allocator_free(ptrs[i]);
+
+    }
+
+    // Unmapped memory blocks are not freed twice
+    passed = passed && alloc->huge_blocks.size == 0;
+    allocator_free(ptrs[0]);
+
+    passed = passed && (alloc->engine != LIST_ENGINE || check_heap_consistency(alloc));
+
+    // Huge memory blocks left behind are unmapped along with the Allocator
+    allocator_malloc(huge_size);
+
+    printf("%s\n", passed ? "huge_block_test PASSED" : "huge_block_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void huge_realloc_test() {
+
+    printf("\n%s\n", "STARTING TEST: huge_realloc_test");
+
+    AllocatorConfig config = default_allocator_config();
+    config.huge_threshold = 64 * 1024;
+
+    Allocator* alloc = create_allocator_with_config(256 * 1024, config);
+    set_allocator(alloc);
+
+    size_t size = 16 * 1024 * 1024;
+    char* buffer = allocator_malloc(size);
+    bool passed = buffer != NULL;
+
+    if (buffer) {
+
+        buffer[0] = 1;
+        buffer[size - 1] = 2;
+
+    }
+
+    // Growing remaps the pages, the contents come along without a copy
+    buffer = allocator_realloc(buffer, 4 * size);
+    passed = passed && buffer && buffer[0] == 1 && buffer[size - 1] == 2;
+    passed = passed && allocator_usable_size(buffer) == 4 * size && alloc->huge_blocks.size == 1;
+
+    if (buffer) { buffer[4 * size - 1] = 3; }
+
+    // Shrinking hands the pages at the end back in place
+    char* shrunk = allocator_realloc(buffer, size / 16);
+    passed = passed && shrunk == buffer && shrunk[0] == 1;
+    passed = passed && allocator_usable_size(shrunk) == size / 16 && alloc->huge_blocks.size == 1;
+
+    allocator_free(shrunk);
+    passed = passed && alloc->huge_blocks.size == 0;
+
+    printf("%s\n", passed ? "huge_realloc_test PASSED" : "huge_realloc_test FAILED");
+
+    destroy_allocator();
+
+}
+
+void shared_heap_test() {
+
+    printf("\n%s\n", "STARTING TEST: shared_heap_test");
+
+    size_t heap_size = 64 * 1024;
+    char name[SHARED_NAME_SIZE];
+    snprintf(name, sizeof(name), "/allocator_test_%d", (int) getpid());
+
+    // Find an address that is free in this process
+    void* address = mmap(NULL, heap_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    munmap(address, heap_size);
+
+    Allocator* alloc = create_shared_allocator(name, address, heap_size, default_allocator_config());
+    bool passed = alloc != NULL && alloc->heap_start == address;
+
+    if (!passed) {
+
+        printf("%s\n", "shared_heap_test FAILED");
+        return;
+
+    }
+
+    // The name of a shared heap is taken until it is destroyed
+    passed = create_shared_allocator(name, address, heap_size, default_allocator_config()) == NULL;
+
+    set_allocator(alloc);
+    char* parent_block = allocator_malloc(32);
+    strcpy(parent_block, "written by the parent");
+
+    int channel[2];
+    pipe(channel);
+    pid_t child = fork();
+
+    if (child == 0) {
+
+        // Map the shared heap anew, as a process not forked from the creator would
+        detach_shared_allocator(alloc);
+        Allocator* attached = attach_shared_allocator(name);
+        bool child_passed = attached == alloc && strcmp(parent_block, "written by the parent") == 0;
+
+        set_allocator(attached);
+        char* child_block = allocator_malloc(64);
+        strcpy(child_block, "written by the child");
+
+        size_t offset = allocator_offset(attached, child_block);
+        write(channel[1], &offset, sizeof(offset));
+
+        // Die while holding the lock of the shared heap
+        acquire_lock(&attached->lock);
+        _exit(child_passed ? 0 : 1);
+
+    }
+
+    size_t offset = 0;
+    int status = 0;
+    read(channel[0], &offset, sizeof(offset));
+    waitpid(child, &status, 0);
+    close(channel[0]);
+    close(channel[1]);
+
+    passed = passed && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+    // The lock left behind by the child is recovered
+    acquire_lock(&alloc->lock);
+
+    char* child_block = allocator_pointer(alloc, offset);
+    passed = passed && strcmp(child_block, "written by the child") == 0;
+    passed = passed && check_heap_consistency(alloc);
+
+    allocator_free(child_block);
+    allocator_free(parent_block);
+    passed = passed && check_heap_consistency(alloc);
+
+    pthread_mutex_unlock(&alloc->lock);
+
+    printf("%s\n", passed ? "shared_heap_test PASSED" : "shared_heap_test FAILED");
+
+    destroy_allocator();
+
+}
+
 void align_size_test() {
 
     size_t factor = 0;
@@ -483,7 +2739,130 @@ int main() {
     realloc_test();
     //heap_full_test();
 
+    best_fit_test();
+
+    invalid_free_test();
+
+    pointer_index_overflow_test();
+
+    next_fit_test();
+
+    custom_placement_test();
+
+    tlsf_test();
+
+    buddy_test();
+
+    slab_test();
+
+    thread_test();
+
+    explicit_handle_test();
+
+    thread_cache_test();
+
+    thread_cache_alternation_test();
+
+    arena_test();
+
+    arena_huge_block_test();
+
+    remote_free_test();
+
+    central_bin_test();
+
+    maintenance_test();
+
+    cpu_cache_test();
+
+    mmap_heap_test();
+
+    shared_heap_test();
+
+    AllocatorConfig config = default_allocator_config();
+    extent_test(config);
+
+    config.engine = TLSF_ENGINE;
+    config.use_thread_cache = true;
+    extent_test(config);
+
+    config = default_allocator_config();
+    trim_test(config);
+
+    config.engine = TLSF_ENGINE;
+    trim_test(config);
+
+    config.engine = BUDDY_ENGINE;
+    trim_test(config);
+
+    config = default_allocator_config();
+    huge_block_test(config);
+
+    config.engine = TLSF_ENGINE;
+    config.use_thread_cache = true;
+    huge_block_test(config);
+
+    huge_realloc_test();
+
+    config = default_allocator_config();
+    stress_test(config);
+
+    config.placement_policy = BEST_FIT;
+    stress_test(config);
+
+    config.placement_policy = ADDRESS_ORDERED_BEST_FIT;
+    stress_test(config);
+
+    config.placement_policy = NEXT_FIT;
+    stress_test(config);
+
+    config = default_allocator_config();
+    config.engine = TLSF_ENGINE;
+    stress_test(config);
+
+    config.engine = BUDDY_ENGINE;
+    stress_test(config);
+
+    // Every engine again with small objects served from slabs
+    config = default_allocator_config();
+    config.use_slabs = true;
+    stress_test(config);
+
+    config.engine = TLSF_ENGINE;
+    stress_test(config);
+
+    config.engine = BUDDY_ENGINE;
+    stress_test(config);
+
+    // Slabs and engines behind the thread caches
+    config = default_allocator_config();
+    config.use_slabs = true;
+    config.use_thread_cache = true;
+    stress_test(config);
+
+    config.engine = TLSF_ENGINE;
+    stress_test(config);
+
+    // Central bins on their own and behind the thread caches
+    config = default_allocator_config();
+    config.use_central_bins = true;
+    stress_test(config);
+
+    config.use_thread_cache = true;
+    config.engine = BUDDY_ENGINE;
+    stress_test(config);
+
+    // The TLSF engine on a mapped heap
+    config = default_allocator_config();
+    config.use_mmap = true;
+    config.engine = TLSF_ENGINE;
+    stress_test(config);
 
+    // CPU caches in front of the central bins
+    config = default_allocator_config();
+    config.use_cpu_cache = true;
+    config.use_central_bins = true;
+    stress_test(config);
 
     printf("\n%s\n", "----TEST ENDED----");
 